@@ -0,0 +1,70 @@
+#pragma once
+
+#include "vector.h"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+// Выделяет память, выровненную по Alignment байт. Размер выделения округляется до кратного Alignment,
+// чтобы последняя кеш-линия буфера не делилась с чужими данными.
+template<typename T, size_t Alignment>
+class AlignedAllocator {
+public:
+    static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+    static constexpr size_t alignment = std::max(Alignment, alignof(T));
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+    T *allocate(size_t n);
+
+    void deallocate(T *buf, size_t n) noexcept;
+
+    bool operator==(const AlignedAllocator &) const noexcept {return true;}
+
+    bool operator!=(const AlignedAllocator &) const noexcept {return false;}
+
+private:
+    static size_t AllocationSize(size_t n) noexcept;
+};
+
+// Политика размещения для второго параметра Vector: Vector<float, Align<64>>
+template<size_t Alignment>
+struct Align {};
+
+template<typename T, size_t Alignment>
+struct AllocatorFor<T, Align<Alignment>> {
+    using type = AlignedAllocator<T, Alignment>;
+};
+
+template<typename T, size_t Alignment>
+size_t AlignedAllocator<T, Alignment>::AllocationSize(size_t n) noexcept {
+    return (n * sizeof(T) + alignment - 1) / alignment * alignment;
+}
+
+template<typename T, size_t Alignment>
+T *AlignedAllocator<T, Alignment>::allocate(size_t n) {
+
+    if (n > (static_cast<size_t>(-1) - alignment) / sizeof(T)) {
+        throw std::bad_array_new_length();
+    }
+
+    return static_cast<T *>(operator new(AllocationSize(n), std::align_val_t(alignment)));
+}
+
+template<typename T, size_t Alignment>
+void AlignedAllocator<T, Alignment>::deallocate(T *buf, size_t n) noexcept {
+    operator delete(buf, AllocationSize(n), std::align_val_t(alignment));
+}
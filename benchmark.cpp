@@ -0,0 +1,478 @@
+// Замеры Vector относительно std::vector. Собирается отдельно от тестов:
+//     g++ -std=c++17 -O2 -DNDEBUG benchmark.cpp -o benchmark
+//     ./benchmark [--format=json|csv] [--filter=подстрока] [--sizes=16,1024,65536] [--repetitions=5] [--min-time-ms=20]
+// Для каждой комбинации операции, контейнера, типа элемента и размера печатается медиана и минимум
+// наносекунд на операцию и отношение медианы к медиане std::vector в той же комбинации.
+
+#include "vector.h"
+#include "small_vector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // Не даёт компилятору выбросить вычисление, результат которого не используется
+    template<typename T>
+    void DoNotOptimize(const T &value) {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+
+    struct Pod64 {
+        uint64_t words[8];
+    };
+
+    // Перемещение может бросить, поэтому std::vector при росте копирует такие элементы
+    struct ThrowingMove {
+        ThrowingMove() = default;
+
+        explicit ThrowingMove(size_t value): value(value) {}
+
+        ThrowingMove(const ThrowingMove &other) = default;
+
+        ThrowingMove(ThrowingMove &&other) noexcept(false): value(other.value) {}
+
+        ThrowingMove &operator=(const ThrowingMove &other) = default;
+
+        ThrowingMove &operator=(ThrowingMove &&other) noexcept(false) {
+            value = other.value;
+            return *this;
+        }
+
+        size_t value = 0;
+    };
+
+    template<typename T>
+    struct ElementTraits;
+
+    template<>
+    struct ElementTraits<int> {
+        static constexpr const char *NAME = "int";
+
+        static int Make(size_t i) {return static_cast<int>(i);}
+
+        static size_t Key(int value) {return static_cast<size_t>(value);}
+    };
+
+    // Строки длиннее буфера SSO, чтобы копирование выделяло память
+    template<>
+    struct ElementTraits<std::string> {
+        static constexpr const char *NAME = "string";
+
+        static std::string Make(size_t i) {return std::string(40, static_cast<char>('a' + i % 26));}
+
+        static size_t Key(const std::string &value) {return value.size() + static_cast<size_t>(value[0]);}
+    };
+
+    template<>
+    struct ElementTraits<Pod64> {
+        static constexpr const char *NAME = "pod64";
+
+        static Pod64 Make(size_t i) {
+            Pod64 value{};
+            value.words[0] = i;
+            return value;
+        }
+
+        static size_t Key(const Pod64 &value) {return value.words[0];}
+    };
+
+    template<>
+    struct ElementTraits<ThrowingMove> {
+        static constexpr const char *NAME = "throwing_move";
+
+        static ThrowingMove Make(size_t i) {return ThrowingMove(i);}
+
+        static size_t Key(const ThrowingMove &value) {return value.value;}
+    };
+
+    // Общий интерфейс контейнеров; по умолчанию — интерфейс Vector
+    template<typename C>
+    struct ContainerOps {
+        template<typename U>
+        static void PushBack(C &c, U &&value) {c.PushBack(std::forward<U>(value));}
+
+        template<typename... Args>
+        static void EmplaceBack(C &c, Args &&...args) {c.EmplaceBack(std::forward<Args>(args)...);}
+
+        static void Reserve(C &c, size_t n) {c.Reserve(n);}
+
+        template<typename U>
+        static void Insert(C &c, size_t index, U &&value) {c.Insert(c.begin() + index, std::forward<U>(value));}
+
+        static void Erase(C &c, size_t index) {c.Erase(c.begin() + index);}
+
+        static size_t Size(const C &c) {return c.Size();}
+    };
+
+    template<typename T>
+    struct ContainerOps<std::vector<T>> {
+        using C = std::vector<T>;
+
+        template<typename U>
+        static void PushBack(C &c, U &&value) {c.push_back(std::forward<U>(value));}
+
+        template<typename... Args>
+        static void EmplaceBack(C &c, Args &&...args) {c.emplace_back(std::forward<Args>(args)...);}
+
+        static void Reserve(C &c, size_t n) {c.reserve(n);}
+
+        template<typename U>
+        static void Insert(C &c, size_t index, U &&value) {c.insert(c.begin() + index, std::forward<U>(value));}
+
+        static void Erase(C &c, size_t index) {c.erase(c.begin() + index);}
+
+        static size_t Size(const C &c) {return c.size();}
+    };
+
+    // Накапливает время только между Start и Stop, подготовка данных в замер не входит
+    class State {
+    public:
+        void Start() {start_ = Clock::now();}
+
+        void Stop() {elapsed_ += Clock::now() - start_;}
+
+        void AddOperations(size_t count) {operations_ += count;}
+
+        double Seconds() const {return std::chrono::duration<double>(elapsed_).count();}
+
+        size_t Operations() const {return operations_;}
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        Clock::time_point start_;
+        Clock::duration elapsed_{};
+        size_t operations_ = 0;
+    };
+
+    using BenchmarkBody = std::function<void(State &, size_t)>;
+
+    template<typename C>
+    C MakeFilled(size_t n) {
+        using T = typename C::value_type;
+        C c;
+        ContainerOps<C>::Reserve(c, n);
+
+        for (size_t i = 0; i != n; ++i) {
+            ContainerOps<C>::PushBack(c, ElementTraits<T>::Make(i));
+        }
+
+        return c;
+    }
+
+    template<typename C>
+    void BenchPushBack(State &state, size_t n) {
+        using T = typename C::value_type;
+        const T value = ElementTraits<T>::Make(n);
+
+        state.Start();
+        C c;
+        for (size_t i = 0; i != n; ++i) {
+            ContainerOps<C>::PushBack(c, value);
+        }
+        DoNotOptimize(c);
+        state.Stop();
+
+        state.AddOperations(n);
+    }
+
+    template<typename C>
+    void BenchEmplaceBack(State &state, size_t n) {
+        using T = typename C::value_type;
+
+        state.Start();
+        C c;
+        for (size_t i = 0; i != n; ++i) {
+            ContainerOps<C>::EmplaceBack(c, ElementTraits<T>::Make(i));
+        }
+        DoNotOptimize(c);
+        state.Stop();
+
+        state.AddOperations(n);
+    }
+
+    template<typename C>
+    void BenchReservePushBack(State &state, size_t n) {
+        using T = typename C::value_type;
+        const T value = ElementTraits<T>::Make(n);
+
+        state.Start();
+        C c;
+        ContainerOps<C>::Reserve(c, n);
+        for (size_t i = 0; i != n; ++i) {
+            ContainerOps<C>::PushBack(c, value);
+        }
+        DoNotOptimize(c);
+        state.Stop();
+
+        state.AddOperations(n);
+    }
+
+    template<typename C>
+    void BenchCopyAssign(State &state, size_t n) {
+        const C source = MakeFilled<C>(n);
+        C target;
+
+        state.Start();
+        target = source;
+        DoNotOptimize(target);
+        state.Stop();
+
+        state.AddOperations(n);
+    }
+
+    template<typename C>
+    void BenchMoveAssign(State &state, size_t n) {
+        C source = MakeFilled<C>(n);
+        C target;
+
+        state.Start();
+        target = std::move(source);
+        source = std::move(target);
+        DoNotOptimize(source);
+        state.Stop();
+
+        state.AddOperations(2);
+    }
+
+    // Вставки и удаления идут в середину, каждая сдвигает половину элементов
+    template<typename C>
+    void BenchInsertMiddle(State &state, size_t n) {
+        using T = typename C::value_type;
+        const size_t count = std::min<size_t>(n, 256);
+        C c = MakeFilled<C>(n);
+        ContainerOps<C>::Reserve(c, n + count);
+        const T value = ElementTraits<T>::Make(n);
+
+        state.Start();
+        for (size_t i = 0; i != count; ++i) {
+            ContainerOps<C>::Insert(c, ContainerOps<C>::Size(c) / 2, value);
+        }
+        DoNotOptimize(c);
+        state.Stop();
+
+        state.AddOperations(count);
+    }
+
+    template<typename C>
+    void BenchEraseMiddle(State &state, size_t n) {
+        const size_t count = std::min<size_t>(n, 256);
+        C c = MakeFilled<C>(n);
+
+        state.Start();
+        for (size_t i = 0; i != count; ++i) {
+            ContainerOps<C>::Erase(c, ContainerOps<C>::Size(c) / 2);
+        }
+        DoNotOptimize(c);
+        state.Stop();
+
+        state.AddOperations(count);
+    }
+
+    template<typename C>
+    void BenchIterate(State &state, size_t n) {
+        using T = typename C::value_type;
+        const C c = MakeFilled<C>(n);
+        size_t sum = 0;
+
+        state.Start();
+        for (const T &item : c) {
+            sum += ElementTraits<T>::Key(item);
+        }
+        DoNotOptimize(sum);
+        state.Stop();
+
+        state.AddOperations(n);
+    }
+
+    struct Benchmark {
+        std::string name;
+        std::string container;
+        std::string element;
+        BenchmarkBody body;
+    };
+
+    struct Result {
+        std::string name;
+        std::string container;
+        std::string element;
+        size_t size;
+        double median_ns;
+        double min_ns;
+        double relative_to_std;
+    };
+
+    const char *BASELINE = "std::vector";
+
+    template<typename C>
+    void AddContainerBenchmarks(std::vector<Benchmark> &out, const std::string &container) {
+        using T = typename C::value_type;
+        const std::string element = ElementTraits<T>::NAME;
+
+        out.push_back({"push_back", container, element, BenchPushBack<C>});
+        out.push_back({"emplace_back", container, element, BenchEmplaceBack<C>});
+        out.push_back({"reserve_push_back", container, element, BenchReservePushBack<C>});
+        out.push_back({"copy_assign", container, element, BenchCopyAssign<C>});
+        out.push_back({"move_assign", container, element, BenchMoveAssign<C>});
+        out.push_back({"insert_middle", container, element, BenchInsertMiddle<C>});
+        out.push_back({"erase_middle", container, element, BenchEraseMiddle<C>});
+        out.push_back({"iterate", container, element, BenchIterate<C>});
+    }
+
+    template<typename T>
+    void AddElementBenchmarks(std::vector<Benchmark> &out) {
+        AddContainerBenchmarks<std::vector<T>>(out, BASELINE);
+        AddContainerBenchmarks<Vector<T>>(out, "Vector");
+        AddContainerBenchmarks<Vector<T, std::allocator<T>, OneAndHalfGrowth>>(out, "Vector<1.5x>");
+        AddContainerBenchmarks<SmallVector<T, 16>>(out, "SmallVector<16>");
+    }
+
+    // Повторяет тело, пока замеренное время не превысит min_seconds; возвращает наносекунды на операцию
+    double RunOnce(const BenchmarkBody &body, size_t n, double min_seconds) {
+        State state;
+
+        do {
+            body(state, n);
+        } while (state.Seconds() < min_seconds);
+
+        return state.Seconds() * 1e9 / static_cast<double>(std::max<size_t>(state.Operations(), 1));
+    }
+
+    struct Options {
+        bool csv = false;
+        std::string filter;
+        std::vector<size_t> sizes{16, 1024, 65536};
+        size_t repetitions = 5;
+        double min_seconds = 0.02;
+    };
+
+    bool StartsWith(const char *arg, const char *prefix) {
+        return std::strncmp(arg, prefix, std::strlen(prefix)) == 0;
+    }
+
+    Options ParseOptions(int argc, char **argv) {
+        Options options;
+
+        for (int i = 1; i < argc; ++i) {
+            const char *arg = argv[i];
+
+            if (std::strcmp(arg, "--format=csv") == 0) {
+                options.csv = true;
+            } else if (std::strcmp(arg, "--format=json") == 0) {
+                options.csv = false;
+            } else if (StartsWith(arg, "--filter=")) {
+                options.filter = arg + std::strlen("--filter=");
+            } else if (StartsWith(arg, "--sizes=")) {
+                options.sizes.clear();
+                for (const char *pos = arg + std::strlen("--sizes="); *pos != '\0';) {
+                    char *end = nullptr;
+                    const size_t size = std::strtoull(pos, &end, 10);
+
+                    if (end == pos) {
+                        std::fprintf(stderr, "bad size list: %s\n", arg);
+                        std::exit(2);
+                    }
+
+                    options.sizes.push_back(size);
+                    pos = *end == ',' ? end + 1 : end;
+                }
+            } else if (StartsWith(arg, "--repetitions=")) {
+                options.repetitions = std::max<size_t>(std::strtoull(arg + std::strlen("--repetitions="), nullptr, 10), 1);
+            } else if (StartsWith(arg, "--min-time-ms=")) {
+                options.min_seconds = std::strtod(arg + std::strlen("--min-time-ms="), nullptr) / 1000;
+            } else {
+                std::fprintf(stderr, "unknown option: %s\n", arg);
+                std::exit(2);
+            }
+        }
+
+        return options;
+    }
+
+    void PrintJson(const std::vector<Result> &results) {
+        std::printf("{\n  \"baseline\": \"%s\",\n  \"results\": [\n", BASELINE);
+
+        for (size_t i = 0; i != results.size(); ++i) {
+            const Result &r = results[i];
+            std::printf("    {\"name\": \"%s\", \"container\": \"%s\", \"element\": \"%s\", \"size\": %zu, "
+                        "\"ns_per_op_median\": %.3f, \"ns_per_op_min\": %.3f, \"relative_to_std\": %.4f}%s\n",
+                        r.name.c_str(), r.container.c_str(), r.element.c_str(), r.size, r.median_ns, r.min_ns,
+                        r.relative_to_std, i + 1 == results.size() ? "" : ",");
+        }
+
+        std::printf("  ]\n}\n");
+    }
+
+    void PrintCsv(const std::vector<Result> &results) {
+        std::printf("name,container,element,size,ns_per_op_median,ns_per_op_min,relative_to_std\n");
+
+        for (const Result &r : results) {
+            std::printf("%s,\"%s\",%s,%zu,%.3f,%.3f,%.4f\n", r.name.c_str(), r.container.c_str(), r.element.c_str(),
+                        r.size, r.median_ns, r.min_ns, r.relative_to_std);
+        }
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const Options options = ParseOptions(argc, argv);
+
+    std::vector<Benchmark> benchmarks;
+    AddElementBenchmarks<int>(benchmarks);
+    AddElementBenchmarks<std::string>(benchmarks);
+    AddElementBenchmarks<Pod64>(benchmarks);
+    AddElementBenchmarks<ThrowingMove>(benchmarks);
+
+    std::vector<Result> results;
+
+    for (const Benchmark &benchmark : benchmarks) {
+        const std::string full_name = benchmark.name + "/" + benchmark.container + "/" + benchmark.element;
+
+        if (full_name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        for (size_t n : options.sizes) {
+            std::vector<double> samples;
+
+            for (size_t i = 0; i != options.repetitions; ++i) {
+                samples.push_back(RunOnce(benchmark.body, n, options.min_seconds));
+            }
+
+            std::sort(samples.begin(), samples.end());
+            results.push_back({benchmark.name, benchmark.container, benchmark.element, n,
+                               samples[samples.size() / 2], samples.front(), 0});
+        }
+    }
+
+    // Отношение к std::vector; если базовая строка отфильтрована, отношение остаётся нулевым
+    for (Result &r : results) {
+        const auto baseline = std::find_if(results.begin(), results.end(), [&r](const Result &other) {
+            return other.container == BASELINE && other.name == r.name && other.element == r.element
+                   && other.size == r.size;
+        });
+
+        if (baseline != results.end() && baseline->median_ns > 0) {
+            r.relative_to_std = r.median_ns / baseline->median_ns;
+        }
+    }
+
+    if (options.csv) {
+        PrintCsv(results);
+    } else {
+        PrintJson(results);
+    }
+}
@@ -0,0 +1,462 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+namespace bit_detail {
+
+    inline constexpr size_t WORD_BITS = sizeof(uint64_t) * CHAR_BIT;
+
+    inline size_t WordsFor(size_t bits) noexcept {return (bits + WORD_BITS - 1) / WORD_BITS;}
+
+    inline size_t PopCount(uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        size_t count = 0;
+        for (; word != 0; word &= word - 1) {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    // word != 0
+    inline size_t CountTrailingZeros(uint64_t word) noexcept {
+        assert(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(word));
+#else
+        size_t count = 0;
+        for (; (word & 1) == 0; word >>= 1) {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    // Позиция rank-го (с нуля) единичного бита слова, rank < PopCount(word)
+    inline size_t SelectInWord(uint64_t word, size_t rank) noexcept {
+        assert(rank < PopCount(word));
+
+        for (; rank != 0; --rank) {
+            word &= word - 1;
+        }
+
+        return CountTrailingZeros(word);
+    }
+
+    // Четыре независимых счётчика, чтобы popcnt соседних слов шли параллельно
+    template<typename PopCountFn>
+    size_t PopCountWordsWith(const uint64_t *words, size_t n, PopCountFn pop_count) noexcept {
+        size_t counts[4] = {};
+        size_t i = 0;
+
+        for (; i + 4 <= n; i += 4) {
+            counts[0] += pop_count(words[i]);
+            counts[1] += pop_count(words[i + 1]);
+            counts[2] += pop_count(words[i + 2]);
+            counts[3] += pop_count(words[i + 3]);
+        }
+
+        for (; i != n; ++i) {
+            counts[0] += pop_count(words[i]);
+        }
+
+        return counts[0] + counts[1] + counts[2] + counts[3];
+    }
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    // Без флага -mpopcnt __builtin_popcountll вызывает программную реализацию, поэтому цикл
+    // собран отдельно с инструкцией popcnt и выбирается, если её поддерживает процессор
+    __attribute__((target("popcnt"))) inline size_t PopCountWordsHardware(const uint64_t *words, size_t n) noexcept {
+        return PopCountWordsWith(words, n, [](uint64_t word) {
+            return static_cast<size_t>(__builtin_popcountll(word));
+        });
+    }
+
+    inline size_t PopCountWords(const uint64_t *words, size_t n) noexcept {
+        static const bool has_popcnt = (__builtin_cpu_init(), __builtin_cpu_supports("popcnt"));
+        return has_popcnt ? PopCountWordsHardware(words, n) : PopCountWordsWith(words, n, PopCount);
+    }
+#else
+    inline size_t PopCountWords(const uint64_t *words, size_t n) noexcept {
+        return PopCountWordsWith(words, n, PopCount);
+    }
+#endif
+
+} // namespace bit_detail
+
+// Вектор битов, упакованных по 64 в слово. Растёт так же, как Vector, на котором хранит слова.
+// Биты за Size() в последнем слове всегда нулевые, поэтому подсчёт и побитовые операции идут целыми словами.
+// Allocator и GrowthPolicy передаются вектору слов, например BitVector<Pooled>.
+template<typename Allocator = std::allocator<uint64_t>, typename GrowthPolicy = DoublingGrowth>
+class BitVector {
+public:
+    using value_type = bool;
+    using WordVector = Vector<uint64_t, Allocator, GrowthPolicy>;
+
+    static constexpr size_t WORD_BITS = bit_detail::WORD_BITS;
+
+    // Ссылка на один бит
+    class Reference {
+    public:
+        Reference(uint64_t *word, uint64_t mask) noexcept
+                : word_(word), mask_(mask) {
+        }
+
+        Reference(const Reference &) = default;
+
+        Reference &operator=(bool value) noexcept {
+            *word_ = (*word_ & ~mask_) | (-static_cast<uint64_t>(value) & mask_);
+            return *this;
+        }
+
+        Reference &operator=(const Reference &other) noexcept {return *this = static_cast<bool>(other);}
+
+        operator bool() const noexcept {return (*word_ & mask_) != 0;}
+
+        void Flip() noexcept {*word_ ^= mask_;}
+
+    private:
+        uint64_t *word_;
+        uint64_t mask_;
+    };
+
+    BitVector() = default;
+
+    explicit BitVector(size_t size, bool value = false) {Resize(size, value);}
+
+    BitVector(std::initializer_list<bool> bits);
+
+    size_t Size() const noexcept {return size_;}
+
+    size_t Capacity() const noexcept {return words_.Capacity() * WORD_BITS;}
+
+    void Reserve(size_t new_capacity) {words_.Reserve(bit_detail::WordsFor(new_capacity));}
+
+    void Resize(size_t new_size, bool value = false);
+
+    void ShrinkToFit() {words_.ShrinkToFit();}
+
+    void Clear() noexcept {
+        words_.Clear();
+        size_ = 0;
+    }
+
+    void PushBack(bool value);
+
+    void PopBack() noexcept;
+
+    Reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Reference(words_.Data() + index / WORD_BITS, Mask(index));
+    }
+
+    bool operator[](size_t index) const noexcept {return Test(index);}
+
+    bool Test(size_t index) const noexcept {
+        assert(index < size_);
+        return (words_[index / WORD_BITS] & Mask(index)) != 0;
+    }
+
+    void Set(size_t index, bool value = true) noexcept {(*this)[index] = value;}
+
+    void Reset(size_t index) noexcept {Set(index, false);}
+
+    void Flip(size_t index) noexcept {(*this)[index].Flip();}
+
+    // Слова с битами: бит i лежит в слове i / 64 на позиции i % 64
+    const WordVector &Words() const noexcept {return words_;}
+
+    // Число единичных битов
+    size_t Count() const noexcept {return bit_detail::PopCountWords(words_.Data(), words_.Size());}
+
+    // Число единичных битов среди первых pos, pos <= Size(). Для частых запросов есть BitRankIndex
+    size_t Rank(size_t pos) const noexcept;
+
+    // Позиция rank-го (с нуля) единичного бита или Size(), если их меньше
+    size_t Select(size_t rank) const noexcept;
+
+    // Позиция первого единичного бита не раньше pos или Size()
+    size_t FindNextSet(size_t pos) const noexcept;
+
+    size_t FindFirstSet() const noexcept {return FindNextSet(0);}
+
+    // Побитовые операции с вектором того же размера
+    BitVector &operator&=(const BitVector &other) noexcept;
+
+    BitVector &operator|=(const BitVector &other) noexcept;
+
+    BitVector &operator^=(const BitVector &other) noexcept;
+
+    // this &= ~other
+    BitVector &AndNot(const BitVector &other) noexcept;
+
+    bool operator==(const BitVector &other) const noexcept {
+        return size_ == other.size_ && std::equal(words_.begin(), words_.end(), other.words_.begin());
+    }
+
+    bool operator!=(const BitVector &other) const noexcept {return !(*this == other);}
+
+    void Swap(BitVector &other) noexcept {
+        words_.Swap(other.words_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    static uint64_t Mask(size_t index) noexcept {return uint64_t(1) << (index % WORD_BITS);}
+
+    // Обнуляет биты последнего слова за Size()
+    void ClearTail() noexcept;
+
+    // Применяет op(a, b) к словам обоих векторов; хвостовые нули op сохраняет
+    template<typename Operation>
+    BitVector &Combine(const BitVector &other, Operation op) noexcept;
+
+    WordVector words_;
+    size_t size_ = 0;
+};
+
+template<typename A, typename G>
+BitVector<A, G> operator&(BitVector<A, G> lhs, const BitVector<A, G> &rhs) noexcept {return lhs &= rhs;}
+
+template<typename A, typename G>
+BitVector<A, G> operator|(BitVector<A, G> lhs, const BitVector<A, G> &rhs) noexcept {return lhs |= rhs;}
+
+template<typename A, typename G>
+BitVector<A, G> operator^(BitVector<A, G> lhs, const BitVector<A, G> &rhs) noexcept {return lhs ^= rhs;}
+
+// Индекс для Rank за O(1) и Select за O(log n): число единиц перед каждым блоком из 8 слов.
+// Занимает 1/8 от размера битов. Становится недействительным после любого изменения вектора
+class BitRankIndex {
+public:
+    static constexpr size_t BLOCK_WORDS = 8;
+
+    // Индекс пустого вектора: Rank(0) и Count() равны 0, Select возвращает 0
+    BitRankIndex()
+            : blocks_(1) {
+    }
+
+    template<typename A, typename G>
+    explicit BitRankIndex(const BitVector<A, G> &bits);
+
+    size_t Rank(size_t pos) const noexcept;
+
+    size_t Select(size_t rank) const noexcept;
+
+    size_t Count() const noexcept {return blocks_.Size() != 0 ? blocks_[blocks_.Size() - 1] : 0;}
+
+private:
+    const uint64_t *words_ = nullptr;
+    size_t word_count_ = 0;
+    size_t size_ = 0;
+    // blocks_[b] — единицы в словах до b * BLOCK_WORDS; последний элемент — общее число
+    Vector<size_t> blocks_;
+};
+
+template<typename Allocator, typename GrowthPolicy>
+BitVector<Allocator, GrowthPolicy>::BitVector(std::initializer_list<bool> bits) {
+    Reserve(bits.size());
+
+    for (bool bit : bits) {
+        PushBack(bit);
+    }
+}
+
+template<typename Allocator, typename GrowthPolicy>
+void BitVector<Allocator, GrowthPolicy>::Resize(size_t new_size, bool value) {
+
+    if (new_size > size_ && value && size_ % WORD_BITS != 0) {
+        words_[words_.Size() - 1] |= ~uint64_t(0) << (size_ % WORD_BITS);
+    }
+
+    const size_t new_words = bit_detail::WordsFor(new_size);
+
+    if (new_words > words_.Size()) {
+        words_.Insert(words_.end(), new_words - words_.Size(), value ? ~uint64_t(0) : uint64_t(0));
+    } else {
+        words_.Resize(new_words);
+    }
+
+    size_ = new_size;
+    ClearTail();
+}
+
+template<typename Allocator, typename GrowthPolicy>
+void BitVector<Allocator, GrowthPolicy>::PushBack(bool value) {
+
+    if (size_ % WORD_BITS == 0) {
+        words_.PushBack(uint64_t(0));
+    }
+
+    words_[words_.Size() - 1] |= static_cast<uint64_t>(value) << (size_ % WORD_BITS);
+    ++size_;
+}
+
+template<typename Allocator, typename GrowthPolicy>
+void BitVector<Allocator, GrowthPolicy>::PopBack() noexcept {
+    assert(size_);
+    --size_;
+
+    if (size_ % WORD_BITS == 0) {
+        words_.PopBack();
+    } else {
+        ClearTail();
+    }
+}
+
+template<typename Allocator, typename GrowthPolicy>
+void BitVector<Allocator, GrowthPolicy>::ClearTail() noexcept {
+
+    if (size_ % WORD_BITS != 0) {
+        words_[words_.Size() - 1] &= Mask(size_) - 1;
+    }
+}
+
+template<typename Allocator, typename GrowthPolicy>
+size_t BitVector<Allocator, GrowthPolicy>::Rank(size_t pos) const noexcept {
+    assert(pos <= size_);
+    const size_t full_words = pos / WORD_BITS;
+    size_t count = bit_detail::PopCountWords(words_.Data(), full_words);
+
+    if (pos % WORD_BITS != 0) {
+        count += bit_detail::PopCount(words_[full_words] & (Mask(pos) - 1));
+    }
+
+    return count;
+}
+
+template<typename Allocator, typename GrowthPolicy>
+size_t BitVector<Allocator, GrowthPolicy>::Select(size_t rank) const noexcept {
+
+    for (size_t i = 0; i != words_.Size(); ++i) {
+        const size_t count = bit_detail::PopCount(words_[i]);
+
+        if (rank < count) {
+            return i * WORD_BITS + bit_detail::SelectInWord(words_[i], rank);
+        }
+
+        rank -= count;
+    }
+
+    return size_;
+}
+
+template<typename Allocator, typename GrowthPolicy>
+size_t BitVector<Allocator, GrowthPolicy>::FindNextSet(size_t pos) const noexcept {
+
+    if (pos >= size_) {
+        return size_;
+    }
+
+    size_t i = pos / WORD_BITS;
+    uint64_t word = words_[i] & (~uint64_t(0) << (pos % WORD_BITS));
+
+    while (word == 0) {
+
+        if (++i == words_.Size()) {
+            return size_;
+        }
+
+        word = words_[i];
+    }
+
+    return i * WORD_BITS + bit_detail::CountTrailingZeros(word);
+}
+
+// Цикл по словам без ветвлений компилятор сам переводит в векторные инструкции
+template<typename Allocator, typename GrowthPolicy>
+template<typename Operation>
+BitVector<Allocator, GrowthPolicy> &BitVector<Allocator, GrowthPolicy>::Combine(const BitVector &other,
+                                                                                Operation op) noexcept {
+    assert(size_ == other.size_);
+    uint64_t *words = words_.Data();
+    const uint64_t *other_words = other.words_.Data();
+    const size_t n = words_.Size();
+
+    for (size_t i = 0; i != n; ++i) {
+        words[i] = op(words[i], other_words[i]);
+    }
+
+    return *this;
+}
+
+template<typename Allocator, typename GrowthPolicy>
+BitVector<Allocator, GrowthPolicy> &BitVector<Allocator, GrowthPolicy>::operator&=(const BitVector &other) noexcept {
+    return Combine(other, [](uint64_t a, uint64_t b) {return a & b;});
+}
+
+template<typename Allocator, typename GrowthPolicy>
+BitVector<Allocator, GrowthPolicy> &BitVector<Allocator, GrowthPolicy>::operator|=(const BitVector &other) noexcept {
+    return Combine(other, [](uint64_t a, uint64_t b) {return a | b;});
+}
+
+template<typename Allocator, typename GrowthPolicy>
+BitVector<Allocator, GrowthPolicy> &BitVector<Allocator, GrowthPolicy>::operator^=(const BitVector &other) noexcept {
+    return Combine(other, [](uint64_t a, uint64_t b) {return a ^ b;});
+}
+
+template<typename Allocator, typename GrowthPolicy>
+BitVector<Allocator, GrowthPolicy> &BitVector<Allocator, GrowthPolicy>::AndNot(const BitVector &other) noexcept {
+    return Combine(other, [](uint64_t a, uint64_t b) {return a & ~b;});
+}
+
+template<typename A, typename G>
+BitRankIndex::BitRankIndex(const BitVector<A, G> &bits)
+        : words_(bits.Words().Data()), word_count_(bits.Words().Size()), size_(bits.Size()) {
+    const size_t block_count = (word_count_ + BLOCK_WORDS - 1) / BLOCK_WORDS;
+    blocks_.ResizeForOverwrite(block_count + 1);
+    size_t count = 0;
+
+    for (size_t b = 0; b != block_count; ++b) {
+        blocks_[b] = count;
+        const size_t first = b * BLOCK_WORDS;
+        count += bit_detail::PopCountWords(words_ + first, std::min(BLOCK_WORDS, word_count_ - first));
+    }
+
+    blocks_[block_count] = count;
+}
+
+inline size_t BitRankIndex::Rank(size_t pos) const noexcept {
+    assert(pos <= size_);
+    const size_t word = pos / bit_detail::WORD_BITS;
+    const size_t block = word / BLOCK_WORDS;
+    size_t count = blocks_[block];
+
+    for (size_t i = block * BLOCK_WORDS; i != word; ++i) {
+        count += bit_detail::PopCount(words_[i]);
+    }
+
+    if (pos % bit_detail::WORD_BITS != 0) {
+        const uint64_t mask = (uint64_t(1) << (pos % bit_detail::WORD_BITS)) - 1;
+        count += bit_detail::PopCount(words_[word] & mask);
+    }
+
+    return count;
+}
+
+// Двоичный поиск по блокам, затем просмотр не больше восьми слов
+inline size_t BitRankIndex::Select(size_t rank) const noexcept {
+
+    if (rank >= Count()) {
+        return size_;
+    }
+
+    const size_t block = static_cast<size_t>(std::upper_bound(blocks_.begin(), blocks_.end(), rank)
+                                             - blocks_.begin()) - 1;
+    rank -= blocks_[block];
+
+    for (size_t i = block * BLOCK_WORDS;; ++i) {
+        const size_t count = bit_detail::PopCount(words_[i]);
+
+        if (rank < count) {
+            return i * bit_detail::WORD_BITS + bit_detail::SelectInWord(words_[i], rank);
+        }
+
+        rank -= count;
+    }
+}
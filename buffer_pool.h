@@ -0,0 +1,297 @@
+#pragma once
+
+#include "geometric_segments.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+struct BufferPoolStats {
+    // Выделения из свободного блока пула
+    size_t hits = 0;
+    // Выделения, ушедшие в глобальный аллокатор
+    size_t misses = 0;
+    // Освобождённые блоки, оставленные в пуле
+    size_t recycled = 0;
+    // Освобождённые блоки, отданные глобальному аллокатору: класс заполнен или блок слишком велик
+    size_t dropped = 0;
+};
+
+// Пул освобождённых буферов одного потока. Буферы от MIN_BLOCK до MAX_BLOCK байт округляются до степени
+// двойки, и у каждого класса размеров свой список свободных блоков с ограничением на их число.
+// Буфер, освобождённый в другом потоке, попадает в пул этого потока: все блоки берутся из общего operator new.
+// Пул потока разрушается раньше статических объектов и thread_local-объектов, созданных до него; контейнеры,
+// которые его пережили, выделяют и освобождают буферы напрямую через operator new и operator delete.
+class BufferPool {
+public:
+    static constexpr size_t MIN_BLOCK = 16;
+    static constexpr size_t MAX_BLOCK = size_t(1) << 20;
+    static constexpr size_t CLASS_COUNT = Log2(MAX_BLOCK) - Log2(MIN_BLOCK) + 1;
+
+    // По умолчанию класс хранит блоки суммарно не больше этого объёма и хотя бы один блок
+    static constexpr size_t DEFAULT_CLASS_BUDGET = size_t(256) << 10;
+
+    BufferPool() noexcept;
+
+    BufferPool(const BufferPool &) = delete;
+
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    ~BufferPool();
+
+    // Пул текущего потока. После его разрушения пользоваться им нельзя, см. AllocateLocal
+    static BufferPool &Local() noexcept {
+        thread_local BufferPool pool(LocalTag{});
+        return pool;
+    }
+
+    // Выделение и освобождение через пул текущего потока, а после его разрушения — через operator new и delete
+    static void *AllocateLocal(size_t bytes);
+
+    static void DeallocateLocal(void *buf, size_t bytes) noexcept;
+
+    // Размер блока, которым будет обслужен запрос на bytes байт
+    static size_t BlockSize(size_t bytes) noexcept;
+
+    void *Allocate(size_t bytes);
+
+    // bytes — тот же размер, что при выделении
+    void Deallocate(void *buf, size_t bytes) noexcept;
+
+    // Ограничение на число свободных блоков класса, которому принадлежит block_size.
+    // Лишние блоки сразу освобождаются. Блоки больше MAX_BLOCK не кешируются, для них вызов ничего не делает
+    void SetCap(size_t block_size, size_t max_blocks) noexcept;
+
+    void SetCapForAll(size_t max_blocks) noexcept;
+
+    // Ограничение по умолчанию: DEFAULT_CLASS_BUDGET байт, но не меньше одного блока
+    static size_t DefaultCap(size_t block_size) noexcept;
+
+    // Восстанавливает ограничения по умолчанию для всех классов
+    void ResetCaps() noexcept;
+
+    // Для блоков больше MAX_BLOCK — 0
+    size_t Cap(size_t block_size) const noexcept {
+        return block_size <= MAX_BLOCK ? classes_[ClassOf(block_size)].cap : 0;
+    }
+
+    // Возвращает все свободные блоки глобальному аллокатору
+    void Trim() noexcept;
+
+    // Байты в свободных блоках
+    size_t CachedBytes() const noexcept;
+
+    const BufferPoolStats &Stats() const noexcept {return stats_;}
+
+    void ResetStats() noexcept {stats_ = BufferPoolStats();}
+
+private:
+    struct LocalTag {};
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    struct SizeClass {
+        FreeBlock *head = nullptr;
+        size_t count = 0;
+        size_t cap = 0;
+    };
+
+    explicit BufferPool(LocalTag) noexcept
+            : BufferPool() {
+        is_local_ = true;
+    }
+
+    static size_t ClassOf(size_t bytes) noexcept;
+
+    static size_t ClassSize(size_t index) noexcept {return MIN_BLOCK << index;}
+
+    void TrimClass(SizeClass &size_class, size_t keep) noexcept;
+
+    SizeClass classes_[CLASS_COUNT];
+    BufferPoolStats stats_;
+    bool is_local_ = false;
+
+    // Тривиально разрушаемый флаг доступен до конца потока, в том числе при разрушении статических объектов
+    inline static thread_local bool local_destroyed_ = false;
+};
+
+// Аллокатор, который берёт буферы из пула текущего потока. Буферы больше BufferPool::MAX_BLOCK
+// идут напрямую в operator new
+template<typename T>
+class PoolAllocator {
+public:
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned types are not pooled");
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    PoolAllocator() = default;
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+    T *allocate(size_t n);
+
+    void deallocate(T *buf, size_t n) noexcept {BufferPool::DeallocateLocal(buf, n * sizeof(T));}
+
+    bool operator==(const PoolAllocator &) const noexcept {return true;}
+
+    bool operator!=(const PoolAllocator &) const noexcept {return false;}
+};
+
+// Политика размещения для второго параметра Vector: Vector<int, Pooled>
+struct Pooled {};
+
+template<typename T>
+struct AllocatorFor<T, Pooled> {
+    using type = PoolAllocator<T>;
+};
+
+template<typename T>
+T *PoolAllocator<T>::allocate(size_t n) {
+
+    if (n > static_cast<size_t>(-1) / sizeof(T)) {
+        throw std::bad_array_new_length();
+    }
+
+    return static_cast<T *>(BufferPool::AllocateLocal(n * sizeof(T)));
+}
+
+inline BufferPool::BufferPool() noexcept {
+    ResetCaps();
+}
+
+inline BufferPool::~BufferPool() {
+    Trim();
+
+    if (is_local_) {
+        local_destroyed_ = true;
+    }
+}
+
+// Размер блока тот же, что у пула: буфер может быть освобождён в пул другого потока
+inline void *BufferPool::AllocateLocal(size_t bytes) {
+    return local_destroyed_ ? operator new(BlockSize(bytes)) : Local().Allocate(bytes);
+}
+
+inline void BufferPool::DeallocateLocal(void *buf, size_t bytes) noexcept {
+
+    if (local_destroyed_) {
+        operator delete(buf);
+    } else {
+        Local().Deallocate(buf, bytes);
+    }
+}
+
+inline size_t BufferPool::DefaultCap(size_t block_size) noexcept {
+    return std::max<size_t>(DEFAULT_CLASS_BUDGET / BlockSize(block_size), 1);
+}
+
+inline void BufferPool::ResetCaps() noexcept {
+
+    for (size_t i = 0; i != CLASS_COUNT; ++i) {
+        SizeClass &size_class = classes_[i];
+        size_class.cap = DefaultCap(ClassSize(i));
+        TrimClass(size_class, size_class.cap);
+    }
+}
+
+inline size_t BufferPool::ClassOf(size_t bytes) noexcept {
+    return bytes <= MIN_BLOCK ? 0 : Log2(bytes - 1) + 1 - Log2(MIN_BLOCK);
+}
+
+inline size_t BufferPool::BlockSize(size_t bytes) noexcept {
+    return bytes > MAX_BLOCK ? bytes : ClassSize(ClassOf(bytes));
+}
+
+inline void *BufferPool::Allocate(size_t bytes) {
+
+    if (bytes > MAX_BLOCK) {
+        ++stats_.misses;
+        return operator new(bytes);
+    }
+
+    SizeClass &size_class = classes_[ClassOf(bytes)];
+
+    if (size_class.head != nullptr) {
+        ++stats_.hits;
+        FreeBlock *block = size_class.head;
+        size_class.head = block->next;
+        --size_class.count;
+        return block;
+    }
+
+    ++stats_.misses;
+    return operator new(BlockSize(bytes));
+}
+
+inline void BufferPool::Deallocate(void *buf, size_t bytes) noexcept {
+
+    if (bytes > MAX_BLOCK) {
+        ++stats_.dropped;
+        operator delete(buf);
+        return;
+    }
+
+    SizeClass &size_class = classes_[ClassOf(bytes)];
+
+    if (size_class.count >= size_class.cap) {
+        ++stats_.dropped;
+        operator delete(buf);
+        return;
+    }
+
+    ++stats_.recycled;
+    size_class.head = ::new(buf) FreeBlock{size_class.head};
+    ++size_class.count;
+}
+
+inline void BufferPool::SetCap(size_t block_size, size_t max_blocks) noexcept {
+
+    if (block_size > MAX_BLOCK) {
+        return;
+    }
+
+    SizeClass &size_class = classes_[ClassOf(block_size)];
+    size_class.cap = max_blocks;
+    TrimClass(size_class, max_blocks);
+}
+
+inline void BufferPool::SetCapForAll(size_t max_blocks) noexcept {
+
+    for (SizeClass &size_class : classes_) {
+        size_class.cap = max_blocks;
+        TrimClass(size_class, max_blocks);
+    }
+}
+
+inline void BufferPool::Trim() noexcept {
+
+    for (SizeClass &size_class : classes_) {
+        TrimClass(size_class, 0);
+    }
+}
+
+inline void BufferPool::TrimClass(SizeClass &size_class, size_t keep) noexcept {
+
+    while (size_class.count > keep) {
+        FreeBlock *block = size_class.head;
+        size_class.head = block->next;
+        --size_class.count;
+        operator delete(block);
+    }
+}
+
+inline size_t BufferPool::CachedBytes() const noexcept {
+    size_t bytes = 0;
+
+    for (size_t i = 0; i != CLASS_COUNT; ++i) {
+        bytes += classes_[i].count * ClassSize(i);
+    }
+
+    return bytes;
+}
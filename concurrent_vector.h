@@ -0,0 +1,167 @@
+#pragma once
+
+#include "vector.h"
+#include "geometric_segments.h"
+
+#include <atomic>
+#include <memory>
+
+// Вектор для одновременной вставки из многих потоков. Индекс под новый элемент резервируется
+// атомарным счётчиком, а память растёт сегментами FirstSegmentSize, 2 * FirstSegmentSize, 4 * ...,
+// поэтому элементы никогда не перемещаются и ссылки на них не инвалидируются.
+// EmplaceBack — это fetch_add и запись в готовый сегмент, без блокировок. Новый сегмент выделяет каждый
+// поток, которому он понадобился, и ставит его через CAS; проигравшие гонку удаляют свою копию.
+// Элемент опубликован, когда IsPublished(index) вернул true или индекс получен от EmplaceBack;
+// только такие элементы можно читать через operator[] параллельно с вставками.
+template<typename T, size_t FirstSegmentSize = 64>
+class ConcurrentVector {
+    using Segments = GeometricSegments<FirstSegmentSize>;
+
+public:
+    using value_type = T;
+
+    ConcurrentVector() = default;
+
+    ConcurrentVector(const ConcurrentVector &) = delete;
+
+    ConcurrentVector &operator=(const ConcurrentVector &) = delete;
+
+    ~ConcurrentVector();
+
+    // Возвращает индекс вставленного элемента. Если конструктор бросил исключение,
+    // зарезервированный индекс остаётся неопубликованным
+    template<typename... Args>
+    size_t EmplaceBack(Args &&... args);
+
+    template<typename Type>
+    size_t PushBack(Type &&value);
+
+    // Заранее выделяет сегменты под первые capacity элементов
+    void Reserve(size_t capacity);
+
+    bool IsPublished(size_t index) const noexcept;
+
+    // Число зарезервированных индексов, включая элементы, которые ещё конструируются
+    size_t Size() const noexcept {return size_.load(std::memory_order_acquire);}
+
+    const T &operator[](size_t index) const noexcept;
+
+    T &operator[](size_t index) noexcept;
+
+private:
+    struct Segment {
+        explicit Segment(size_t capacity)
+                : data(capacity), published(new std::atomic<bool>[capacity]()) {
+        }
+
+        RawMemory<T> data;
+        std::unique_ptr<std::atomic<bool>[]> published;
+    };
+
+    Segment &AcquireSegment(size_t segment);
+
+    std::atomic<Segment *> segments_[Segments::MAX_SEGMENTS] = {};
+    std::atomic<size_t> size_ = 0;
+};
+
+template<typename T, size_t FirstSegmentSize>
+ConcurrentVector<T, FirstSegmentSize>::~ConcurrentVector() {
+    const size_t size = size_.load(std::memory_order_acquire);
+
+    for (size_t segment = 0; segment != Segments::MAX_SEGMENTS; ++segment) {
+        Segment *s = segments_[segment].load(std::memory_order_acquire);
+
+        if (s == nullptr) {
+            continue;
+        }
+
+        const size_t begin = Segments::Begin(segment);
+        const size_t count = size > begin ? std::min(size - begin, Segments::Size(segment)) : 0;
+
+        for (size_t i = 0; i != count; ++i) {
+
+            if (s->published[i].load(std::memory_order_relaxed)) {
+                std::destroy_at(s->data + i);
+            }
+        }
+
+        delete s;
+    }
+}
+
+// Лишнее выделение при гонке дешевле, чем ожидание потока, который выделяет сегмент
+template<typename T, size_t FirstSegmentSize>
+typename ConcurrentVector<T, FirstSegmentSize>::Segment &
+ConcurrentVector<T, FirstSegmentSize>::AcquireSegment(size_t segment) {
+    Segment *s = segments_[segment].load(std::memory_order_acquire);
+
+    if (s != nullptr) {
+        return *s;
+    }
+
+    std::unique_ptr<Segment> new_segment = std::make_unique<Segment>(Segments::Size(segment));
+
+    if (segments_[segment].compare_exchange_strong(s, new_segment.get(), std::memory_order_acq_rel,
+                                                   std::memory_order_acquire)) {
+        return *new_segment.release();
+    }
+
+    return *s;
+}
+
+template<typename T, size_t FirstSegmentSize>
+void ConcurrentVector<T, FirstSegmentSize>::Reserve(size_t capacity) {
+
+    if (capacity != 0) {
+
+        for (size_t segment = 0, last = Segments::SegmentOf(capacity - 1); segment <= last; ++segment) {
+            AcquireSegment(segment);
+        }
+    }
+}
+
+template<typename T, size_t FirstSegmentSize>
+template<typename... Args>
+size_t ConcurrentVector<T, FirstSegmentSize>::EmplaceBack(Args &&... args) {
+    const size_t index = size_.fetch_add(1, std::memory_order_acq_rel);
+    const size_t segment = Segments::SegmentOf(index);
+    const size_t offset = index - Segments::Begin(segment);
+
+    Segment &s = AcquireSegment(segment);
+    new (s.data + offset) T(std::forward<Args>(args)...);
+    s.published[offset].store(true, std::memory_order_release);
+
+    return index;
+}
+
+template<typename T, size_t FirstSegmentSize>
+template<typename Type>
+size_t ConcurrentVector<T, FirstSegmentSize>::PushBack(Type &&value) {
+    return EmplaceBack(std::forward<Type>(value));
+}
+
+template<typename T, size_t FirstSegmentSize>
+bool ConcurrentVector<T, FirstSegmentSize>::IsPublished(size_t index) const noexcept {
+
+    if (index >= Size()) {
+        return false;
+    }
+
+    const size_t segment = Segments::SegmentOf(index);
+    const Segment *s = segments_[segment].load(std::memory_order_acquire);
+
+    return s != nullptr && s->published[index - Segments::Begin(segment)].load(std::memory_order_acquire);
+}
+
+template<typename T, size_t FirstSegmentSize>
+T &ConcurrentVector<T, FirstSegmentSize>::operator[](size_t index) noexcept {
+    assert(IsPublished(index));
+
+    const size_t segment = Segments::SegmentOf(index);
+    return segments_[segment].load(std::memory_order_acquire)->data[index - Segments::Begin(segment)];
+}
+
+template<typename T, size_t FirstSegmentSize>
+const T &ConcurrentVector<T, FirstSegmentSize>::operator[](size_t index) const noexcept {
+    return const_cast<ConcurrentVector &>(*this)[index];
+}
@@ -0,0 +1,301 @@
+#pragma once
+
+#include "flat_set.h"
+
+#include <stdexcept>
+#include <utility>
+
+// Упорядоченный словарь: ключи и значения лежат в двух параллельных Vector, поэтому поиск
+// проходит только по плотному массиву ключей. Вставка одной пары сдвигает хвосты обоих векторов,
+// много пар лучше вставлять через InsertRange. Итераторы становятся недействительными после любого изменения.
+template<typename K, typename V, typename Compare = std::less<K>>
+class FlatMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+
+    // Итератор произвольного доступа по парам; разыменование возвращает std::pair ссылок
+    template<typename Mapped>
+    class EntryIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<K, std::remove_const_t<Mapped>>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::pair<const K &, Mapped &>;
+
+        EntryIterator() = default;
+
+        EntryIterator(const K *key, Mapped *value) noexcept
+                : key_(key), value_(value) {
+        }
+
+        // Неконстантный итератор приводится к константному
+        template<typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Mapped>>>
+        EntryIterator(const EntryIterator<Other> &other) noexcept
+                : key_(other.KeyPtr()), value_(other.ValuePtr()) {
+        }
+
+        reference operator*() const noexcept {return {*key_, *value_};}
+        reference operator[](difference_type n) const noexcept {return {key_[n], value_[n]};}
+
+        EntryIterator &operator++() noexcept {++key_; ++value_; return *this;}
+        EntryIterator &operator--() noexcept {--key_; --value_; return *this;}
+        EntryIterator operator++(int) noexcept {EntryIterator old = *this; ++*this; return old;}
+        EntryIterator operator--(int) noexcept {EntryIterator old = *this; --*this; return old;}
+
+        EntryIterator &operator+=(difference_type n) noexcept {key_ += n; value_ += n; return *this;}
+        EntryIterator &operator-=(difference_type n) noexcept {key_ -= n; value_ -= n; return *this;}
+        EntryIterator operator+(difference_type n) const noexcept {return EntryIterator(key_ + n, value_ + n);}
+        EntryIterator operator-(difference_type n) const noexcept {return EntryIterator(key_ - n, value_ - n);}
+        friend EntryIterator operator+(difference_type n, const EntryIterator &it) noexcept {return it + n;}
+
+        difference_type operator-(const EntryIterator &other) const noexcept {return key_ - other.key_;}
+
+        bool operator==(const EntryIterator &other) const noexcept {return key_ == other.key_;}
+        bool operator!=(const EntryIterator &other) const noexcept {return key_ != other.key_;}
+        bool operator<(const EntryIterator &other) const noexcept {return key_ < other.key_;}
+        bool operator>(const EntryIterator &other) const noexcept {return key_ > other.key_;}
+        bool operator<=(const EntryIterator &other) const noexcept {return key_ <= other.key_;}
+        bool operator>=(const EntryIterator &other) const noexcept {return key_ >= other.key_;}
+
+        const K *KeyPtr() const noexcept {return key_;}
+        Mapped *ValuePtr() const noexcept {return value_;}
+
+    private:
+        const K *key_ = nullptr;
+        Mapped *value_ = nullptr;
+    };
+
+    using iterator = EntryIterator<V>;
+    using const_iterator = EntryIterator<const V>;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare &comp)
+            : comp_(comp) {
+    }
+
+    // Элементы диапазона — пары с полями first и second
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    FlatMap(InputIt first, InputIt last, const Compare &comp = Compare());
+
+    FlatMap(std::initializer_list<std::pair<K, V>> items, const Compare &comp = Compare())
+            : FlatMap(items.begin(), items.end(), comp) {}
+
+    iterator begin() noexcept {return {keys_.Data(), values_.Data()};}
+    iterator end() noexcept {return begin() + Size();}
+    const_iterator cbegin() const noexcept {return {keys_.Data(), values_.Data()};}
+    const_iterator cend() const noexcept {return cbegin() + Size();}
+    const_iterator begin() const noexcept {return cbegin();}
+    const_iterator end() const noexcept {return cend();}
+
+    size_t Size() const noexcept {return keys_.Size();}
+
+    size_t Capacity() const noexcept {return std::min(keys_.Capacity(), values_.Capacity());}
+
+    void Reserve(size_t new_capacity);
+
+    void ShrinkToFit();
+
+    void Clear() noexcept {
+        keys_.Clear();
+        values_.Clear();
+    }
+
+    // Ключи по возрастанию и значения в том же порядке
+    const Vector<K> &Keys() const noexcept {return keys_;}
+    const Vector<V> &Values() const noexcept {return values_;}
+    Vector<V> &Values() noexcept {return values_;}
+
+    iterator LowerBound(const K &key) {return begin() + LowerBoundIndex(key);}
+    const_iterator LowerBound(const K &key) const {return begin() + LowerBoundIndex(key);}
+
+    iterator Find(const K &key) {return begin() + FindIndex(key);}
+    const_iterator Find(const K &key) const {return begin() + FindIndex(key);}
+
+    bool Contains(const K &key) const {return FindIndex(key) != Size();}
+
+    // Бросает std::out_of_range, если ключа нет
+    V &At(const K &key);
+    const V &At(const K &key) const;
+
+    // Вставляет значение по умолчанию, если ключа нет
+    V &operator[](const K &key) {return (*TryEmplace(key).first).second;}
+
+    // Строит значение из args, только если ключа ещё нет. Возвращает позицию ключа и true, если он вставлен
+    template <typename Key, typename... Args>
+    std::pair<iterator, bool> TryEmplace(Key&& key, Args&&... args);
+
+    std::pair<iterator, bool> Insert(const K &key, const V &value) {return TryEmplace(key, value);}
+    std::pair<iterator, bool> Insert(K &&key, V &&value) {return TryEmplace(std::move(key), std::move(value));}
+
+    // Сортирует новые пары и сливает их с имеющимися за один проход в новые буферы.
+    // Значения уже имеющихся ключей не заменяются. Если слияние бросило, словарь не меняется
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    void InsertRange(InputIt first, InputIt last);
+
+    iterator Erase(const_iterator pos);
+
+    // Возвращает число удалённых пар
+    size_t Erase(const K &key);
+
+    void Swap(FlatMap &other) noexcept {
+        keys_.Swap(other.keys_);
+        values_.Swap(other.values_);
+        std::swap(comp_, other.comp_);
+    }
+
+private:
+    size_t LowerBoundIndex(const K &key) const {
+        return flat_detail::LowerBound(keys_.Data(), keys_.Size(), key, comp_);
+    }
+
+    // Size(), если ключа нет
+    size_t FindIndex(const K &key) const;
+
+    Vector<K> keys_;
+    Vector<V> values_;
+    [[no_unique_address]] Compare comp_;
+};
+
+template<typename K, typename V, typename Compare>
+template<typename InputIt, typename>
+FlatMap<K, V, Compare>::FlatMap(InputIt first, InputIt last, const Compare &comp)
+        : comp_(comp) {
+    InsertRange(first, last);
+}
+
+template<typename K, typename V, typename Compare>
+void FlatMap<K, V, Compare>::Reserve(size_t new_capacity) {
+    keys_.Reserve(new_capacity);
+    values_.Reserve(new_capacity);
+}
+
+template<typename K, typename V, typename Compare>
+void FlatMap<K, V, Compare>::ShrinkToFit() {
+    keys_.ShrinkToFit();
+    values_.ShrinkToFit();
+}
+
+template<typename K, typename V, typename Compare>
+size_t FlatMap<K, V, Compare>::FindIndex(const K &key) const {
+    const size_t index = LowerBoundIndex(key);
+    return index != Size() && !comp_(key, keys_[index]) ? index : Size();
+}
+
+template<typename K, typename V, typename Compare>
+V &FlatMap<K, V, Compare>::At(const K &key) {
+    const size_t index = FindIndex(key);
+
+    if (index == Size()) {
+        throw std::out_of_range("FlatMap: key not found");
+    }
+
+    return values_[index];
+}
+
+template<typename K, typename V, typename Compare>
+const V &FlatMap<K, V, Compare>::At(const K &key) const {
+    return const_cast<FlatMap &>(*this).At(key);
+}
+
+// Место в обоих векторах резервируется заранее, и если вставка значения бросила, ключ удаляется обратно
+template<typename K, typename V, typename Compare>
+template<typename Key, typename... Args>
+std::pair<typename FlatMap<K, V, Compare>::iterator, bool> FlatMap<K, V, Compare>::TryEmplace(Key&& key,
+                                                                                           Args&&... args) {
+    const size_t index = LowerBoundIndex(key);
+
+    if (index != Size() && !comp_(key, keys_[index])) {
+        return {begin() + index, false};
+    }
+
+    keys_.Emplace(keys_.begin() + index, std::forward<Key>(key));
+
+    try {
+        values_.Emplace(values_.begin() + index, std::forward<Args>(args)...);
+    } catch (...) {
+        keys_.Erase(keys_.begin() + index);
+        throw;
+    }
+
+    return {begin() + index, true};
+}
+
+template<typename K, typename V, typename Compare>
+template<typename InputIt, typename>
+void FlatMap<K, V, Compare>::InsertRange(InputIt first, InputIt last) {
+    Vector<K> new_keys;
+    Vector<V> new_values;
+
+    if constexpr (IsForwardIteratorV<InputIt>) {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        new_keys.Reserve(count);
+        new_values.Reserve(count);
+    }
+
+    for (; first != last; ++first) {
+        new_keys.EmplaceBack(first->first);
+        new_values.EmplaceBack(first->second);
+    }
+
+    if (new_keys.Size() == 0) {
+        return;
+    }
+
+    const Vector<size_t> order = flat_detail::SortedOrder(new_keys.Size(), [&new_keys](size_t j) -> const K & {
+        return new_keys[j];
+    }, comp_);
+
+    // Имеющиеся пары переносятся, только если ни ключ, ни значение не бросают при перемещении:
+    // иначе после ошибки в словаре мог бы остаться ключ или значение, из которого уже переместили.
+    // Новые пары временные, их можно перемещать всегда
+    constexpr bool MOVE_ON_MERGE = std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>;
+    Vector<K> merged_keys;
+    Vector<V> merged_values;
+    merged_keys.Reserve(keys_.Size() + new_keys.Size());
+    merged_values.Reserve(keys_.Size() + new_keys.Size());
+
+    flat_detail::MergeUnique(keys_.Size(), order,
+                             [this](size_t i) -> const K & {return keys_[i];},
+                             [&new_keys](size_t j) -> const K & {return new_keys[j];},
+                             comp_,
+                             [&](size_t i) {
+
+                                 if constexpr (MOVE_ON_MERGE) {
+                                     merged_keys.PushBack(std::move(keys_[i]));
+                                     merged_values.PushBack(std::move(values_[i]));
+                                 } else {
+                                     merged_keys.PushBack(std::as_const(keys_[i]));
+                                     merged_values.PushBack(std::as_const(values_[i]));
+                                 }
+                             },
+                             [&](size_t j) {
+                                 merged_keys.PushBack(std::move(new_keys[j]));
+                                 merged_values.PushBack(std::move(new_values[j]));
+                             });
+
+    keys_.Swap(merged_keys);
+    values_.Swap(merged_values);
+}
+
+template<typename K, typename V, typename Compare>
+typename FlatMap<K, V, Compare>::iterator FlatMap<K, V, Compare>::Erase(const_iterator pos) {
+    const size_t index = static_cast<size_t>(pos - cbegin());
+    keys_.Erase(keys_.begin() + index);
+    values_.Erase(values_.begin() + index);
+    return begin() + index;
+}
+
+template<typename K, typename V, typename Compare>
+size_t FlatMap<K, V, Compare>::Erase(const K &key) {
+    const size_t index = FindIndex(key);
+
+    if (index == Size()) {
+        return 0;
+    }
+
+    Erase(cbegin() + index);
+    return 1;
+}
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <utility>
+
+namespace flat_detail {
+
+    // Двоичный поиск без ветвлений: на каждом шаге выбирается одна из половин условным присваиванием,
+    // поэтому число итераций зависит только от n и нет ошибок предсказания переходов.
+    // Обе возможные следующие середины запрашиваются заранее, пока идёт текущее сравнение.
+    template<typename K, typename Key, typename Compare>
+    size_t LowerBound(const K *keys, size_t n, const Key &key, const Compare &comp) {
+
+        if (n == 0) {
+            return 0;
+        }
+
+        const K *base = keys;
+
+        while (n > 1) {
+            const size_t half = n / 2;
+#if defined(__GNUC__)
+            __builtin_prefetch(base + half / 2);
+            __builtin_prefetch(base + half + half / 2);
+#endif
+            base = comp(base[half], key) ? base + half : base;
+            n -= half;
+        }
+
+        return static_cast<size_t>(base - keys) + static_cast<size_t>(comp(*base, key));
+    }
+
+    // Порядок, в котором нужно взять count новых элементов, чтобы их ключи шли по возрастанию.
+    // Сортировка устойчивая, поэтому из равных ключей первым идёт встретившийся раньше.
+    template<typename KeyAt, typename Compare>
+    Vector<size_t> SortedOrder(size_t count, KeyAt key_at, const Compare &comp) {
+        Vector<size_t> order;
+        order.ResizeForOverwrite(count);
+        std::iota(order.begin(), order.end(), size_t(0));
+
+        std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+            return comp(key_at(lhs), key_at(rhs));
+        });
+
+        return order;
+    }
+
+    // Сливает old_count уже упорядоченных уникальных ключей с новыми в порядке order за один проход.
+    // take_old(i) и take_new(j) дописывают элемент в результат. Из равных ключей остаётся старый,
+    // из равных новых — первый по order.
+    template<typename OldKeyAt, typename NewKeyAt, typename Compare, typename TakeOld, typename TakeNew>
+    void MergeUnique(size_t old_count, const Vector<size_t> &order, OldKeyAt old_key, NewKeyAt new_key,
+                     const Compare &comp, TakeOld take_old, TakeNew take_new) {
+        const size_t new_count = order.Size();
+        size_t i = 0;
+        size_t j = 0;
+
+        // Дубликаты пропускаются до того, как элемент заберут: после take ключ может быть перемещён
+        while (i < old_count || j < new_count) {
+
+            if (j == new_count || (i < old_count && !comp(new_key(order[j]), old_key(i)))) {
+
+                while (j < new_count && !comp(old_key(i), new_key(order[j]))) {
+                    ++j;
+                }
+
+                take_old(i++);
+            } else {
+                size_t next = j + 1;
+
+                while (next < new_count && !comp(new_key(order[j]), new_key(order[next]))) {
+                    ++next;
+                }
+
+                take_new(order[j]);
+                j = next;
+            }
+        }
+    }
+
+} // namespace flat_detail
+
+// Упорядоченное множество уникальных ключей в одном непрерывном Vector. Поиск — двоичный без ветвлений,
+// вставка одного ключа сдвигает хвост, поэтому много ключей лучше вставлять через InsertRange.
+// Итераторы становятся недействительными после любого изменения.
+template<typename K, typename Compare = std::less<K>>
+class FlatSet {
+public:
+    using key_type = K;
+    using value_type = K;
+    using iterator = const K*;
+    using const_iterator = const K*;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare &comp)
+            : comp_(comp) {
+    }
+
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    FlatSet(InputIt first, InputIt last, const Compare &comp = Compare());
+
+    FlatSet(std::initializer_list<K> items, const Compare &comp = Compare())
+            : FlatSet(items.begin(), items.end(), comp) {}
+
+    const_iterator begin() const noexcept {return keys_.begin();}
+    const_iterator end() const noexcept {return keys_.end();}
+    const_iterator cbegin() const noexcept {return keys_.cbegin();}
+    const_iterator cend() const noexcept {return keys_.cend();}
+
+    size_t Size() const noexcept {return keys_.Size();}
+
+    size_t Capacity() const noexcept {return keys_.Capacity();}
+
+    void Reserve(size_t new_capacity) {keys_.Reserve(new_capacity);}
+
+    void ShrinkToFit() {keys_.ShrinkToFit();}
+
+    void Clear() noexcept {keys_.Clear();}
+
+    const K &operator[](size_t index) const noexcept {return keys_[index];}
+
+    // Ключи по возрастанию
+    const Vector<K> &Keys() const noexcept {return keys_;}
+
+    const_iterator LowerBound(const K &key) const;
+
+    const_iterator Find(const K &key) const;
+
+    bool Contains(const K &key) const {return Find(key) != end();}
+
+    // Возвращает позицию ключа и true, если его не было
+    template <typename... Args>
+    std::pair<iterator, bool> Emplace(Args&&... args);
+
+    std::pair<iterator, bool> Insert(const K &key) {return Emplace(key);}
+    std::pair<iterator, bool> Insert(K &&key) {return Emplace(std::move(key));}
+
+    // Сортирует новые ключи и сливает их с имеющимися за один проход в новый буфер.
+    // Ключи, которые уже есть, не заменяются. Если слияние бросило, множество не меняется
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    void InsertRange(InputIt first, InputIt last);
+
+    iterator Erase(const_iterator pos) {return keys_.Erase(pos);}
+
+    // Возвращает число удалённых ключей
+    size_t Erase(const K &key);
+
+    void Swap(FlatSet &other) noexcept {
+        keys_.Swap(other.keys_);
+        std::swap(comp_, other.comp_);
+    }
+
+private:
+    Vector<K> keys_;
+    [[no_unique_address]] Compare comp_;
+};
+
+template<typename K, typename Compare>
+template<typename InputIt, typename>
+FlatSet<K, Compare>::FlatSet(InputIt first, InputIt last, const Compare &comp)
+        : comp_(comp) {
+    InsertRange(first, last);
+}
+
+template<typename K, typename Compare>
+typename FlatSet<K, Compare>::const_iterator FlatSet<K, Compare>::LowerBound(const K &key) const {
+    return begin() + flat_detail::LowerBound(keys_.Data(), keys_.Size(), key, comp_);
+}
+
+template<typename K, typename Compare>
+typename FlatSet<K, Compare>::const_iterator FlatSet<K, Compare>::Find(const K &key) const {
+    const const_iterator pos = LowerBound(key);
+    return pos != end() && !comp_(key, *pos) ? pos : end();
+}
+
+// Ключ строится до поиска, так как аргументы могут быть не ключом, а тем, из чего он строится
+template<typename K, typename Compare>
+template<typename... Args>
+std::pair<typename FlatSet<K, Compare>::iterator, bool> FlatSet<K, Compare>::Emplace(Args&&... args) {
+    K key(std::forward<Args>(args)...);
+    const const_iterator pos = LowerBound(key);
+
+    if (pos != end() && !comp_(key, *pos)) {
+        return {pos, false};
+    }
+
+    return {keys_.Emplace(pos, std::move(key)), true};
+}
+
+template<typename K, typename Compare>
+template<typename InputIt, typename>
+void FlatSet<K, Compare>::InsertRange(InputIt first, InputIt last) {
+    Vector<K> items(first, last);
+
+    if (items.Size() == 0) {
+        return;
+    }
+
+    const Vector<size_t> order = flat_detail::SortedOrder(items.Size(), [&items](size_t j) -> const K & {
+        return items[j];
+    }, comp_);
+
+    Vector<K> merged;
+    merged.Reserve(keys_.Size() + items.Size());
+
+    flat_detail::MergeUnique(keys_.Size(), order,
+                             [this](size_t i) -> const K & {return keys_[i];},
+                             [&items](size_t j) -> const K & {return items[j];},
+                             comp_,
+                             [this, &merged](size_t i) {merged.PushBack(std::move_if_noexcept(keys_[i]));},
+                             [&items, &merged](size_t j) {merged.PushBack(std::move_if_noexcept(items[j]));});
+
+    keys_.Swap(merged);
+}
+
+template<typename K, typename Compare>
+size_t FlatSet<K, Compare>::Erase(const K &key) {
+    const const_iterator pos = Find(key);
+
+    if (pos == end()) {
+        return 0;
+    }
+
+    keys_.Erase(pos);
+    return 1;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cassert>
+#include <climits>
+#include <cstddef>
+
+// Номер старшего единичного бита, value > 0
+constexpr size_t Log2(size_t value) noexcept {
+    assert(value != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return sizeof(unsigned long long) * CHAR_BIT - 1 - __builtin_clzll(value);
+#else
+    size_t result = 0;
+    while (value >>= 1) {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+// Разбиение индексов на сегменты размером FirstSegmentSize, 2 * FirstSegmentSize, 4 * ...
+// Номер сегмента и смещение в нём считаются за O(1) по старшему биту index + FirstSegmentSize.
+template<size_t FirstSegmentSize>
+struct GeometricSegments {
+    static_assert(FirstSegmentSize != 0 && (FirstSegmentSize & (FirstSegmentSize - 1)) == 0,
+                  "FirstSegmentSize must be a power of two");
+
+    // Сколько сегментов нужно, чтобы адресовать любой size_t
+    static constexpr size_t MAX_SEGMENTS = sizeof(size_t) * CHAR_BIT - Log2(FirstSegmentSize);
+
+    static size_t SegmentOf(size_t index) noexcept {
+        return Log2(index + FirstSegmentSize) - Log2(FirstSegmentSize);
+    }
+
+    // Индекс первого элемента сегмента, он же суммарная ёмкость сегментов до него
+    static size_t Begin(size_t segment) noexcept {
+        return FirstSegmentSize * ((size_t(1) << segment) - 1);
+    }
+
+    static size_t Size(size_t segment) noexcept {
+        return FirstSegmentSize << segment;
+    }
+};
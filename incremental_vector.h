@@ -0,0 +1,241 @@
+#pragma once
+
+#include "vector.h"
+#include "index_iterator.h"
+
+// Вектор с ограниченной задержкой роста: при переполнении выделяется новый буфер, а элементы
+// переносятся в него порциями по MigrationStep при последующих изменениях вектора.
+// Пока идёт перенос, элементы с индексами [migrated_, old_size_) лежат в старом буфере,
+// остальные — в новом. Итераторы хранят индекс и остаются корректными во время переноса.
+template<typename T, size_t MigrationStep = 32, typename GrowthPolicy = DoublingGrowth>
+class IncrementalVector {
+    static_assert(MigrationStep > 0);
+
+public:
+    using iterator = IndexIterator<IncrementalVector, T>;
+    using const_iterator = IndexIterator<const IncrementalVector, const T>;
+
+    IncrementalVector() = default;
+
+    IncrementalVector(const IncrementalVector &other);
+
+    IncrementalVector(IncrementalVector &&other) noexcept;
+
+    IncrementalVector &operator=(const IncrementalVector &other);
+
+    IncrementalVector &operator=(IncrementalVector &&other) noexcept;
+
+    ~IncrementalVector();
+
+    iterator begin() noexcept {return iterator(this, 0);}
+    iterator end() noexcept {return iterator(this, size_);}
+    const_iterator cbegin() const noexcept {return const_iterator(this, 0);}
+    const_iterator cend() const noexcept {return const_iterator(this, size_);}
+    const_iterator begin() const noexcept {return cbegin();}
+    const_iterator end() const noexcept {return cend();}
+
+    // Начинает перенос в буфер на new_capacity элементов, но не выполняет его целиком
+    void Reserve(size_t new_capacity);
+
+    template <typename Type>
+    void PushBack(Type&& value);
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+
+    void PopBack();
+
+    // Переносит оставшиеся элементы старого буфера за один вызов
+    void FinishMigration();
+
+    bool IsMigrating() const noexcept {return migrated_ != old_size_;}
+
+    size_t Size() const noexcept {return size_;}
+
+    size_t Capacity() const noexcept {return data_.Capacity();}
+
+    const T &operator[](size_t index) const noexcept;
+
+    T &operator[](size_t index) noexcept;
+
+    void Swap(IncrementalVector &other) noexcept;
+
+private:
+    void StartMigration(size_t new_capacity);
+
+    void MigrateStep(size_t count);
+
+    RawMemory<T> data_;
+    RawMemory<T> old_data_;
+    size_t size_ = 0;
+    size_t migrated_ = 0;
+    size_t old_size_ = 0;
+};
+
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+IncrementalVector<T, MigrationStep, GrowthPolicy>::IncrementalVector(const IncrementalVector &other)
+        : data_(other.size_) {
+
+    for (; size_ != other.size_; ++size_) {
+        try {
+            new (data_ + size_) T(other[size_]);
+        } catch (...) {
+            std::destroy_n(data_.GetAddress(), size_);
+            throw;
+        }
+    }
+}
+
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+IncrementalVector<T, MigrationStep, GrowthPolicy>::IncrementalVector(IncrementalVector &&other) noexcept
+        : data_(std::move(other.data_)),
+          old_data_(std::move(other.old_data_)),
+          size_(std::exchange(other.size_, 0)),
+          migrated_(std::exchange(other.migrated_, 0)),
+          old_size_(std::exchange(other.old_size_, 0)) {
+}
+
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+IncrementalVector<T, MigrationStep, GrowthPolicy> &IncrementalVector<T, MigrationStep, GrowthPolicy>::operator=(
+        const IncrementalVector &other) {
+
+    if (this != &other) {
+        IncrementalVector other_copy(other);
+        Swap(other_copy);
+    }
+
+    return *this;
+}
+
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+IncrementalVector<T, MigrationStep, GrowthPolicy> &IncrementalVector<T, MigrationStep, GrowthPolicy>::operator=(
+        IncrementalVector &&other) noexcept {
+    Swap(other);
+    return *this;
+}
+
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+IncrementalVector<T, MigrationStep, GrowthPolicy>::~IncrementalVector() {
+    std::destroy_n(data_.GetAddress(), migrated_);
+    std::destroy_n(old_data_.GetAddress() + migrated_, old_size_ - migrated_);
+    std::destroy_n(data_.GetAddress() + old_size_, size_ - old_size_);
+}
+
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+void IncrementalVector<T, MigrationStep, GrowthPolicy>::Swap(IncrementalVector &other) noexcept {
+    data_.Swap(other.data_);
+    old_data_.Swap(other.old_data_);
+    std::swap(size_, other.size_);
+    std::swap(migrated_, other.migrated_);
+    std::swap(old_size_, other.old_size_);
+}
+
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+T &IncrementalVector<T, MigrationStep, GrowthPolicy>::operator[](size_t index) noexcept {
+    assert(index < size_);
+
+    if (index >= migrated_ && index < old_size_) {
+        return old_data_[index];
+    }
+
+    return data_[index];
+}
+
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+const T &IncrementalVector<T, MigrationStep, GrowthPolicy>::operator[](size_t index) const noexcept {
+    return const_cast<IncrementalVector &>(*this)[index];
+}
+
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+void IncrementalVector<T, MigrationStep, GrowthPolicy>::Reserve(size_t new_capacity) {
+
+    if (new_capacity > data_.Capacity()) {
+        FinishMigration();
+        StartMigration(new_capacity);
+        MigrateStep(MigrationStep);
+    }
+}
+
+// Вызывается только после завершения предыдущего переноса: если буфер заполнился раньше,
+// EmplaceBack и Reserve сначала доводят перенос до конца
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+void IncrementalVector<T, MigrationStep, GrowthPolicy>::StartMigration(size_t new_capacity) {
+    assert(!IsMigrating());
+
+    RawMemory<T> new_data(new_capacity);
+    old_data_.Swap(data_);
+    data_.Swap(new_data);
+
+    migrated_ = 0;
+    old_size_ = size_;
+}
+
+// Переносит до count элементов. Если копирование бросает исключение, порция остаётся в старом буфере
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+void IncrementalVector<T, MigrationStep, GrowthPolicy>::MigrateStep(size_t count) {
+    const size_t n = std::min(count, old_size_ - migrated_);
+
+    UninitializedRelocateN(old_data_.GetAddress() + migrated_, n, data_.GetAddress() + migrated_);
+    migrated_ += n;
+
+    if (!IsMigrating()) {
+
+        if (old_data_.Capacity() != 0) {
+            RawMemory<T>().Swap(old_data_);
+        }
+
+        migrated_ = old_size_ = 0;
+    }
+}
+
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+void IncrementalVector<T, MigrationStep, GrowthPolicy>::FinishMigration() {
+    MigrateStep(old_size_ - migrated_);
+}
+
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+template<typename Type>
+void IncrementalVector<T, MigrationStep, GrowthPolicy>::PushBack(Type&& value) {
+    EmplaceBack(std::forward<Type>(value));
+}
+
+// Новый элемент строится раньше переноса порции, так как аргументы могут ссылаться на переносимые элементы
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+template<typename... Args>
+T& IncrementalVector<T, MigrationStep, GrowthPolicy>::EmplaceBack(Args&&... args) {
+
+    if (data_.Capacity() <= size_ && IsMigrating()) {
+        // Буфер заполнился раньше окончания переноса (после Reserve): аргументы нужно сохранить до FinishMigration
+        T new_s(std::forward<Args>(args)...);
+        FinishMigration();
+        return EmplaceBack(std::move(new_s));
+    }
+
+    if (data_.Capacity() <= size_) {
+        StartMigration(GrowthPolicy::NextCapacity(data_.Capacity(), size_ + 1, sizeof(T)));
+    }
+
+    new (data_ + size_) T(std::forward<Args>(args)...);
+
+    try {
+        MigrateStep(MigrationStep);
+    } catch (...) {
+        std::destroy_at(data_ + size_);
+        throw;
+    }
+
+    return data_[size_++];
+}
+
+template<typename T, size_t MigrationStep, typename GrowthPolicy>
+void IncrementalVector<T, MigrationStep, GrowthPolicy>::PopBack() {
+    assert(size_);
+    std::destroy_at(&(*this)[size_ - 1]);
+
+    if (IsMigrating() && size_ == old_size_) {
+        --old_size_;
+        MigrateStep(0);
+    }
+
+    --size_;
+}
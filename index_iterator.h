@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// Итератор произвольного доступа, хранящий контейнер и индекс. Подходит контейнерам,
+// элементы которых лежат не в одном буфере: разыменование идёт через Container::operator[].
+template<typename Container, typename Value>
+class IndexIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value *;
+    using reference = Value &;
+
+    IndexIterator() = default;
+
+    IndexIterator(Container *container, size_t index) noexcept
+            : container_(container), index_(index) {
+    }
+
+    reference operator*() const noexcept {return (*container_)[index_];}
+    pointer operator->() const noexcept {return &(*container_)[index_];}
+    reference operator[](difference_type n) const noexcept {return (*container_)[index_ + n];}
+
+    IndexIterator &operator++() noexcept {++index_; return *this;}
+    IndexIterator &operator--() noexcept {--index_; return *this;}
+    IndexIterator operator++(int) noexcept {IndexIterator old = *this; ++index_; return old;}
+    IndexIterator operator--(int) noexcept {IndexIterator old = *this; --index_; return old;}
+
+    IndexIterator &operator+=(difference_type n) noexcept {index_ += n; return *this;}
+    IndexIterator &operator-=(difference_type n) noexcept {index_ -= n; return *this;}
+    IndexIterator operator+(difference_type n) const noexcept {return IndexIterator(container_, index_ + n);}
+    IndexIterator operator-(difference_type n) const noexcept {return IndexIterator(container_, index_ - n);}
+    friend IndexIterator operator+(difference_type n, const IndexIterator &it) noexcept {return it + n;}
+
+    difference_type operator-(const IndexIterator &other) const noexcept {
+        return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+    }
+
+    bool operator==(const IndexIterator &other) const noexcept {return index_ == other.index_;}
+    bool operator!=(const IndexIterator &other) const noexcept {return index_ != other.index_;}
+    bool operator<(const IndexIterator &other) const noexcept {return index_ < other.index_;}
+    bool operator>(const IndexIterator &other) const noexcept {return index_ > other.index_;}
+    bool operator<=(const IndexIterator &other) const noexcept {return index_ <= other.index_;}
+    bool operator>=(const IndexIterator &other) const noexcept {return index_ >= other.index_;}
+
+    size_t Index() const noexcept {return index_;}
+
+private:
+    Container *container_ = nullptr;
+    size_t index_ = 0;
+};
@@ -0,0 +1,34 @@
+// Сборка без VECTOR_INSTRUMENTATION: хуки должны компилироваться в пустые и ничего не считать.
+// main.cpp собирается с подсчётом, поэтому этот режим проверяется отдельной программой:
+//     g++ -std=c++17 -Wall -Wextra instrumentation_off.cpp -o instrumentation_off && ./instrumentation_off
+
+#include "vector.h"
+#include "realloc_allocator.h"
+#include "tagged_allocator.h"
+
+#include <cassert>
+#include <string>
+
+static_assert(!VECTOR_INSTRUMENTATION_ENABLED);
+
+struct OffTag {
+    static constexpr const char* NAME = "off";
+};
+
+int main() {
+    VectorCounters& off = CountersForTag<OffTag>();
+    {
+        Vector<int, Tagged<OffTag, ReallocAllocator<int>>> in_place;
+        Vector<std::string, Tagged<OffTag>> strings;
+        for (int i = 0; i < 100; ++i) {
+            in_place.PushBack(i);
+            strings.PushBack(std::to_string(i));
+        }
+        strings.ShrinkToFit();
+        Vector<std::string, Tagged<OffTag>> strings_copy(strings);
+        assert(in_place[99] == 99 && strings_copy[99] == "99");
+    }
+    const VectorStats stats = off.Snapshot();
+    assert(stats.allocations == 0 && stats.deallocations == 0 && stats.reallocations == 0);
+    assert(stats.relocated_elements == 0 && stats.moved_elements == 0 && stats.wasted_bytes == 0);
+}
@@ -1,8 +1,36 @@
+// Тесты собираются с подсчётом статистики векторов, чтобы проверять и его
+#define VECTOR_INSTRUMENTATION 1
+
 #include "vector.h"
+#include "aligned_allocator.h"
+#include "bit_vector.h"
+#include "buffer_pool.h"
+#include "concurrent_vector.h"
+#include "flat_map.h"
+#include "incremental_vector.h"
+#include "mmap_vector.h"
+#include "parallel_vector.h"
+#include "realloc_allocator.h"
+#include "ring_vector.h"
+#include "shared_vector.h"
+#include "small_vector.h"
+#include "soa_vector.h"
+#include "stable_vector.h"
+#include "static_vector.h"
+#include "tagged_allocator.h"
+#include "vector_kernels.h"
+#include "vector_serialization.h"
 
+#include <atomic>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <list>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -98,8 +126,105 @@ namespace {
         static inline int num_destroyed = 0;
     };
 
+    struct RelocatableObj {
+        RelocatableObj() = default;
+
+        explicit RelocatableObj(int id)
+                : id(id)  //
+        {
+        }
+
+        RelocatableObj(const RelocatableObj& other)
+                : id(other.id)  //
+        {
+            ++num_copied;
+        }
+
+        RelocatableObj(RelocatableObj&& other) noexcept
+                : id(other.id)  //
+        {
+            ++num_moved;
+        }
+
+        RelocatableObj& operator=(const RelocatableObj& other) = default;
+        RelocatableObj& operator=(RelocatableObj&& other) = default;
+
+        ~RelocatableObj() {
+            ++num_destroyed;
+        }
+
+        static void ResetCounters() {
+            num_copied = 0;
+            num_moved = 0;
+            num_destroyed = 0;
+        }
+
+        int id = 0;
+
+        static inline int num_copied = 0;
+        static inline int num_moved = 0;
+        static inline int num_destroyed = 0;
+    };
+
+    // Аллокатор с состоянием, который считает выделения и не распространяется при перемещении
+    template <typename T>
+    struct CountingAllocator {
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::false_type;
+
+        explicit CountingAllocator(int id = 0)
+                : id(id)  //
+        {
+        }
+
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>& other)
+                : id(other.id)  //
+        {
+        }
+
+        T* allocate(size_t n) {
+            ++num_allocations;
+            return static_cast<T*>(operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t) noexcept {
+            ++num_deallocations;
+            operator delete(p);
+        }
+
+        template <typename... Args>
+        void construct(T* p, Args&&... args) {
+            ++num_constructed;
+            new (p) T(std::forward<Args>(args)...);
+        }
+
+        bool operator==(const CountingAllocator& other) const noexcept {
+            return id == other.id;
+        }
+
+        bool operator!=(const CountingAllocator& other) const noexcept {
+            return id != other.id;
+        }
+
+        static void ResetCounters() {
+            num_allocations = 0;
+            num_deallocations = 0;
+            num_constructed = 0;
+        }
+
+        int id = 0;
+
+        static inline int num_allocations = 0;
+        static inline int num_deallocations = 0;
+        static inline int num_constructed = 0;
+    };
+
 }  // namespace
 
+template <>
+struct IsTriviallyRelocatable<RelocatableObj> : std::true_type {};
+
 void Test1() {
     Obj::ResetCounters();
     const size_t SIZE = 100500;
@@ -380,6 +505,1820 @@ void Test5() {
     }
 }
 
+void Test6() {
+    const size_t SIZE = 1000;
+    {
+        RelocatableObj::ResetCounters();
+        Vector<RelocatableObj> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        v.Reserve(SIZE * 4);
+        // Перенос при реаллокации не должен вызывать конструкторы и деструкторы
+        assert(RelocatableObj::num_moved == 0);
+        assert(RelocatableObj::num_copied == 0);
+        assert(RelocatableObj::num_destroyed == 0);
+
+        v.Emplace(v.begin() + 1, -1);
+        v.Erase(v.begin() + 2);
+        assert(v.Size() == SIZE);
+        assert(v[0].id == 0 && v[1].id == -1 && v[2].id == 2);
+        assert(v[SIZE - 1].id == static_cast<int>(SIZE - 1));
+        assert(RelocatableObj::num_moved == 0);
+        assert(RelocatableObj::num_destroyed == 1);
+    }
+    {
+        Vector<int> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.PushBack(i);
+        }
+        v.Insert(v.begin(), -1);
+        v.Insert(v.begin() + 500, -2);
+        v.Erase(v.begin() + 500);
+        v.Erase(v.begin());
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(v[i] == static_cast<int>(i));
+        }
+    }
+    {
+        Vector<std::unique_ptr<int>> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.EmplaceBack(std::make_unique<int>(i));
+        }
+        v.Emplace(v.begin(), std::make_unique<int>(-1));
+        v.Erase(v.begin());
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(*v[i] == static_cast<int>(i));
+        }
+    }
+    {
+        // Присваивание перемещением бросает: новый элемент и лишний элемент за концом не утекают
+        struct ThrowingAssign {
+            ThrowingAssign(std::string value, bool throw_on_assign)
+                    : value(std::move(value)), throw_on_assign(throw_on_assign) {
+            }
+            ThrowingAssign(ThrowingAssign&&) = default;
+            ThrowingAssign& operator=(ThrowingAssign&& other) {
+                if (other.throw_on_assign) {
+                    throw std::runtime_error("assign");
+                }
+                value = std::move(other.value);
+                return *this;
+            }
+            std::string value;
+            bool throw_on_assign;
+        };
+        Vector<ThrowingAssign> v;
+        v.Reserve(4);
+        v.EmplaceBack(std::string(100, 'a'), false);
+        v.EmplaceBack(std::string(100, 'b'), false);
+        try {
+            v.Emplace(v.begin() + 1, std::string(100, 'x'), true);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 2 && v[0].value == std::string(100, 'a'));
+    }
+}
+
+void Test7() {
+    const size_t SIZE = 100;
+    {
+        CountingAllocator<int>::ResetCounters();
+        {
+            Vector<int, CountingAllocator<int>> v{CountingAllocator<int>(1)};
+            for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+                v.PushBack(i);
+            }
+            assert(CountingAllocator<int>::num_constructed == SIZE);
+
+            Vector<int, CountingAllocator<int>> v_other{CountingAllocator<int>(2)};
+            // Аллокаторы не равны и не распространяются, поэтому элементы переносятся по одному
+            v_other = std::move(v);
+            assert(v_other.GetAllocator().id == 2);
+            assert(v_other.Size() == SIZE);
+            assert(v_other[SIZE - 1] == static_cast<int>(SIZE - 1));
+
+            Vector<int, CountingAllocator<int>> v_same{CountingAllocator<int>(2)};
+            const int allocations = CountingAllocator<int>::num_allocations;
+            v_same = std::move(v_other);
+            assert(CountingAllocator<int>::num_allocations == allocations);
+            assert(v_same.Size() == SIZE);
+            assert(v_other.Size() == 0);
+        }
+        assert(CountingAllocator<int>::num_allocations == CountingAllocator<int>::num_deallocations);
+    }
+    {
+        std::pmr::monotonic_buffer_resource resource;
+        pmr::Vector<pmr::Vector<int>> v(&resource);
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.EmplaceBack().PushBack(i);
+        }
+        for (size_t i = 0; i < SIZE; ++i) {
+            // Вложенные векторы получают ресурс внешнего вектора
+            assert(v[i].GetAllocator().resource() == &resource);
+            assert(v[i][0] == static_cast<int>(i));
+        }
+
+        pmr::Vector<pmr::Vector<int>> v_copy(v);
+        assert(v_copy.GetAllocator().resource() == std::pmr::get_default_resource());
+        assert(v_copy[SIZE - 1][0] == static_cast<int>(SIZE - 1));
+    }
+}
+
+void Test8() {
+    const size_t SIZE = 100'000;
+    {
+        Vector<int, ReallocAllocator<int>> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.PushBack(i);
+        }
+        v.Emplace(v.begin(), -1);
+        v.Erase(v.begin());
+        // Аргумент, ссылающийся на элемент вектора, должен пережить расширение буфера
+        while (v.Size() < v.Capacity()) {
+            v.PushBack(0);
+        }
+        v.PushBack(v[1]);
+        assert(v[v.Size() - 1] == 1);
+        while (v.Size() < v.Capacity()) {
+            v.PushBack(0);
+        }
+        v.Emplace(v.begin() + 1, v[2]);
+        assert(v[1] == 2 && v[2] == 1 && v[3] == 2);
+    }
+    {
+        // Порог в одну страницу, чтобы проверить переход с realloc на mmap/mremap
+        Vector<double, ReallocAllocator<double, 4096>> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<double>(i));
+        }
+        v.Reserve(SIZE * 8);
+        assert(v.Capacity() == SIZE * 8);
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(v[i] == static_cast<double>(i));
+        }
+        Vector<double, ReallocAllocator<double, 4096>> v_copy(v);
+        assert(v_copy[SIZE - 1] == static_cast<double>(SIZE - 1));
+    }
+    {
+        Obj::ResetCounters();
+        {
+            Vector<Obj, ReallocAllocator<Obj>> v;
+            for (int i = 0; i < 100; ++i) {
+                v.EmplaceBack(i);
+            }
+            assert(v[99].id == 99);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test9() {
+    const size_t INLINE_SIZE = 8;
+    const int ID = 42;
+    {
+        Obj::ResetCounters();
+        {
+            SmallVector<Obj, INLINE_SIZE> v;
+            assert(v.Capacity() == INLINE_SIZE);
+            assert(v.Size() == 0);
+            assert(Obj::GetAliveObjectCount() == 0);
+            for (int i = 0; i < static_cast<int>(INLINE_SIZE); ++i) {
+                v.EmplaceBack(i);
+            }
+            assert(v.IsInline());
+            v.Emplace(v.begin(), ID);
+            assert(!v.IsInline());
+            assert(v.Size() == INLINE_SIZE + 1);
+            assert(v[0].id == ID && v[INLINE_SIZE].id == static_cast<int>(INLINE_SIZE - 1));
+            v.Erase(v.begin());
+            assert(v[0].id == 0);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, INLINE_SIZE> v(INLINE_SIZE / 2);
+        v[0].id = ID;
+        SmallVector<Obj, INLINE_SIZE> v_copy(v);
+        assert(v_copy.IsInline());
+        assert(v_copy[0].id == ID);
+        assert(&v_copy[0] != &v[0]);
+
+        SmallVector<Obj, INLINE_SIZE> v_moved(std::move(v_copy));
+        assert(v_moved.IsInline());
+        assert(v_moved.Size() == INLINE_SIZE / 2);
+        assert(v_moved[0].id == ID);
+
+        SmallVector<Obj, INLINE_SIZE> v_large(INLINE_SIZE * 2);
+        v_large.Swap(v_moved);
+        assert(v_large.Size() == INLINE_SIZE / 2 && v_large[0].id == ID);
+        assert(v_moved.Size() == INLINE_SIZE * 2);
+
+        v_large = v_moved;
+        assert(v_large.Size() == INLINE_SIZE * 2);
+        v_moved = std::move(v);
+        assert(v_moved.Size() == INLINE_SIZE / 2 && v_moved[0].id == ID);
+    }
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, INLINE_SIZE> v(INLINE_SIZE);
+        try {
+            v[INLINE_SIZE / 2].throw_on_copy = true;
+            SmallVector<Obj, INLINE_SIZE> v_copy(v);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(Obj::GetAliveObjectCount() == INLINE_SIZE);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            // Буфер из кучи передаётся без копирования элементов, источник возвращается во встроенный буфер
+            SmallVector<Obj, INLINE_SIZE> heap(INLINE_SIZE * 2);
+            heap[0].id = ID;
+            const Obj* data = heap.Data();
+            SmallVector<Obj, INLINE_SIZE> moved(std::move(heap));
+            assert(moved.Data() == data && moved[0].id == ID && !moved.IsInline());
+            assert(heap.IsInline() && heap.Size() == 0 && heap.Capacity() == INLINE_SIZE);
+            assert(Obj::GetAliveObjectCount() == INLINE_SIZE * 2);
+
+            SmallVector<Obj, INLINE_SIZE> target(2);
+            target = std::move(moved);
+            assert(target.Data() == data && moved.IsInline() && moved.Size() == 0);
+            assert(Obj::GetAliveObjectCount() == INLINE_SIZE * 2);
+
+            SmallVector<Obj, INLINE_SIZE> other_heap(INLINE_SIZE * 3);
+            const Obj* other_data = other_heap.Data();
+            target.Swap(other_heap);
+            assert(target.Data() == other_data && other_heap.Data() == data && other_heap[0].id == ID);
+
+            SmallVector<Obj, INLINE_SIZE> small(3);
+            small[0].id = ID + 1;
+            small.Swap(other_heap);
+            assert(small.Data() == data && small[0].id == ID && small.Size() == INLINE_SIZE * 2);
+            assert(other_heap.IsInline() && other_heap.Size() == 3 && other_heap[0].id == ID + 1);
+
+            SmallVector<Obj, INLINE_SIZE> tiny(5);
+            tiny[4].id = ID + 2;
+            other_heap.Swap(tiny);
+            assert(other_heap.Size() == 5 && other_heap[4].id == ID + 2 && tiny.Size() == 3 && tiny[0].id == ID + 1);
+            assert(tiny.IsInline() && other_heap.IsInline());
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        SmallVector<TestObj, 1> v(1);
+        // Переполнение встроенного буфера не должно портить добавляемый элемент вектора
+        v.PushBack(v[0]);
+        assert(!v.IsInline());
+        assert(v[0].IsAlive());
+        assert(v[1].IsAlive());
+    }
+}
+
+void Test10() {
+    const size_t SIZE = 1000;
+    {
+        Vector<float, Align<64>> v;
+        static_assert(Vector<float, Align<64>>::Alignment() == 64);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(reinterpret_cast<uintptr_t>(&v[0]) % 64 == 0);
+        }
+        Vector<float, Align<64>> v_copy(v);
+        assert(reinterpret_cast<uintptr_t>(&v_copy[0]) % 64 == 0);
+        assert(v_copy[SIZE - 1] == static_cast<float>(SIZE - 1));
+    }
+    {
+        struct alignas(128) Block {
+            char data[16];
+        };
+        // Выравнивание типа учитывается и без явной политики
+        static_assert(Vector<Block>::Alignment() == 128);
+        static_assert(Vector<Block, Align<32>>::Alignment() == 128);
+        Vector<Block> v(3);
+        v.Reserve(SIZE);
+        assert(reinterpret_cast<uintptr_t>(&v[0]) % 128 == 0);
+    }
+}
+
+void Test11() {
+    using namespace std::literals;
+    {
+        Vector<int> v{1, 2, 3};
+        assert(v.Size() == 3 && v.Capacity() == 3);
+        const int items[] = {10, 11, 12, 13};
+        auto it = v.Insert(v.begin() + 1, std::begin(items), std::end(items));
+        assert(it == v.begin() + 1);
+        assert(v.Size() == 7);
+        const int expected[] = {1, 10, 11, 12, 13, 2, 3};
+        assert(std::equal(v.begin(), v.end(), std::begin(expected)));
+
+        v.Insert(v.begin(), 2, v[6]);
+        assert(v.Size() == 9 && v[0] == 3 && v[1] == 3 && v[2] == 1);
+
+        v.Assign({5, 6});
+        assert(v.Size() == 2 && v[0] == 5 && v[1] == 6);
+        v.Assign(4, 7);
+        assert(v.Size() == 4 && v[3] == 7);
+    }
+    {
+        Obj::ResetCounters();
+        const size_t SIZE = 100;
+        {
+            Vector<Obj> v;
+            v.Reserve(SIZE);
+            std::list<Obj> items;
+            for (int i = 0; i < 10; ++i) {
+                items.emplace_back(i);
+            }
+            v.Append(items.begin(), items.end());
+            v.Insert(v.begin() + 2, items.begin(), items.end());
+            v.Insert(v.begin() + 15, items.begin(), std::next(items.begin(), 3));
+            assert(v.Size() == 23);
+            assert(v.Capacity() == SIZE);
+            assert(v[0].id == 0 && v[2].id == 0 && v[11].id == 9 && v[12].id == 2);
+            assert(v[15].id == 0 && v[18].id == 5 && v[22].id == 9);
+
+            auto front = std::next(items.begin(), 5);
+            front->throw_on_copy = true;
+            try {
+                // При реаллокации вставка должна давать строгую гарантию
+                v.Insert(v.begin() + 1, items.begin(), items.end());
+                v.Insert(v.begin() + 1, SIZE, items.front());
+                v.ShrinkToFit();
+                v.Insert(v.begin() + 1, items.begin(), items.end());
+                assert(false && "Exception is expected");
+            } catch (const std::runtime_error&) {
+            }
+            assert(v.Size() == 33 + SIZE);
+            assert(v[0].id == 0 && v[1].id == 0 && v[SIZE + 1].id == 0);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        std::istringstream input("1 2 3 4");
+        Vector<int> v{0, 5};
+        v.Insert(v.begin() + 1, std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert(v.Size() == 6);
+        for (int i = 0; i < 6; ++i) {
+            assert(v[i] == i);
+        }
+    }
+    {
+        SmallVector<std::string, 4> small{"a"s, "b"s};
+        small.Append(small.begin(), small.begin());
+        small.Insert(small.end(), {"c"s, "d"s});
+        assert(small.IsInline() && small.Size() == 4 && small[3] == "d"s);
+        small.Assign(5, "z"s);
+        assert(!small.IsInline() && small.Size() == 5);
+    }
+    {
+        Vector<std::string> v{"a"s, "d"s};
+        Vector<std::string> items{"b"s, "c"s};
+        v.Insert(v.begin() + 1, items.begin(), items.end());
+        v.Insert(v.end(), 1, "e"s);
+        v.Insert(v.begin() + 1, 3, "x"s);
+        v.Insert(v.begin() + 7, 1, v[0]);
+        const Vector<std::string> expected{"a"s, "x"s, "x"s, "x"s, "b"s, "c"s, "d"s, "a"s, "e"s};
+        assert(v.Size() == expected.Size());
+        assert(std::equal(v.begin(), v.end(), expected.begin()));
+    }
+}
+
+void Test12() {
+    const size_t SIZE = 1000;
+    {
+        Obj::ResetCounters();
+        {
+            Vector<Obj> v;
+            for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+                v.EmplaceBack(i);
+            }
+            auto it = v.Erase(v.begin() + 10, v.begin() + 20);
+            assert(it->id == 20);
+            assert(v.Size() == SIZE - 10);
+            assert(Obj::GetAliveObjectCount() == SIZE - 10);
+
+            const size_t removed = v.EraseIf([](const Obj& obj) {
+                return obj.id % 2 == 1;
+            });
+            assert(removed == (SIZE - 10) / 2);
+            assert(v.Size() == (SIZE - 10) / 2);
+            assert(Obj::GetAliveObjectCount() == (SIZE - 10) / 2);
+            for (size_t i = 0; i < v.Size(); ++i) {
+                assert(v[i].id % 2 == 0);
+            }
+
+            it = v.UnorderedErase(v.begin());
+            assert(it->id == static_cast<int>(SIZE - 2));
+            assert(v.Size() == (SIZE - 10) / 2 - 1);
+            v.UnorderedErase(v.end() - 1);
+            assert(v.Size() == (SIZE - 10) / 2 - 2);
+            assert(v.Erase(v.begin(), v.begin()) == v.begin());
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        Vector<int> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.PushBack(i);
+        }
+        v.Erase(v.begin(), v.begin() + SIZE / 2);
+        assert(v.Size() == SIZE / 2 && v[0] == static_cast<int>(SIZE / 2));
+        assert(v.EraseIf([](int x) { return x < 600; }) == 100);
+        v.UnorderedErase(v.begin());
+        assert(v[0] == static_cast<int>(SIZE - 1));
+        assert(v.Size() == SIZE / 2 - 101);
+    }
+}
+
+void Test13() {
+    const size_t SIZE = 1000;
+    {
+        Vector<char> v(SIZE, DefaultInit);
+        assert(v.Size() == SIZE);
+        std::memset(v.Data(), 'a', v.Size());
+        v.ResizeForOverwrite(SIZE * 2);
+        assert(v.Size() == SIZE * 2 && v[SIZE - 1] == 'a');
+
+        const std::string text = "hello";
+        v.ResizeAndOverwrite(SIZE * 4, [&text](char* buf, size_t n) {
+            assert(n == SIZE * 4);
+            std::memcpy(buf + SIZE * 2, text.data(), text.size());
+            return SIZE * 2 + text.size();
+        });
+        assert(v.Size() == SIZE * 2 + text.size());
+        assert(v.Capacity() >= SIZE * 4);
+        assert(std::string(v.begin() + SIZE * 2, v.end()) == text);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            // Для нетривиальных типов инициализация по умолчанию вызывает конструктор
+            Vector<Obj> v(SIZE, DefaultInit);
+            assert(Obj::num_default_constructed == SIZE);
+            try {
+                v.ResizeAndOverwrite(SIZE * 2, [](Obj*, size_t) -> size_t {
+                    throw std::runtime_error("Oops");
+                });
+                assert(false && "Exception is expected");
+            } catch (const std::runtime_error&) {
+            }
+            assert(v.Size() == SIZE);
+            assert(Obj::GetAliveObjectCount() == SIZE);
+            v.ResizeAndOverwrite(SIZE / 2, [](Obj* buf, size_t n) {
+                buf[0].id = static_cast<int>(n);
+                return n / 2;
+            });
+            assert(v.Size() == SIZE / 4 && v[0].id == static_cast<int>(SIZE / 2));
+            assert(Obj::GetAliveObjectCount() == SIZE / 4);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test14() {
+    {
+        Vector<int, std::allocator<int>, OneAndHalfGrowth> v;
+        Vector<size_t> capacities;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+            if (capacities.Size() == 0 || capacities[capacities.Size() - 1] != v.Capacity()) {
+                capacities.PushBack(v.Capacity());
+            }
+        }
+        const size_t expected[] = {1, 2, 3, 4, 6, 9, 13, 19, 28, 42, 63, 94, 141};
+        assert(std::equal(capacities.begin(), capacities.end(), std::begin(expected), std::end(expected)));
+
+        v.ShrinkToFit();
+        assert(v.Capacity() == 100);
+        assert(v[99] == 99);
+        v.Clear();
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+    }
+    {
+        Vector<char, std::allocator<char>, PageRoundedGrowth<>> v(5000);
+        v.PushBack('a');
+        assert(v.Capacity() == 12288);
+        Vector<char, std::allocator<char>, SizeClassGrowth<>> v_classes(100);
+        v_classes.PushBack('a');
+        assert(v_classes.Capacity() == 224);
+        v_classes.Resize(4097);
+        assert(v_classes.Capacity() == 5120);
+    }
+    {
+        Vector<int, ReallocAllocator<int>> v(1000);
+        v[999] = 42;
+        v.Resize(500);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 500);
+        v.PushBack(42);
+        assert(v[500] == 42);
+    }
+    {
+        SmallVector<int, 4> v{1, 2, 3, 4, 5};
+        assert(!v.IsInline());
+        v.PopBack();
+        v.ShrinkToFit();
+        assert(v.Capacity() == 4);
+        assert(v[3] == 4);
+    }
+}
+
+void Test15() {
+    const size_t SIZE = 1000;
+    const size_t STEP = 1;
+    {
+        Obj::ResetCounters();
+        {
+            IncrementalVector<Obj, STEP> v;
+            size_t max_moved_per_push = 0;
+            for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+                const int moved = Obj::num_moved;
+                v.EmplaceBack(i);
+                max_moved_per_push = std::max(max_moved_per_push, static_cast<size_t>(Obj::num_moved - moved));
+
+                // Индексы и итераторы видят оба буфера во время переноса
+                assert(v[i / 2].id == i / 2);
+                assert((v.begin() + i)->id == i);
+            }
+            assert(max_moved_per_push <= STEP);
+            assert(v.Size() == SIZE);
+            assert(v.IsMigrating());
+            assert(static_cast<size_t>(v.end() - v.begin()) == SIZE);
+            for (size_t i = 0; i < SIZE; ++i) {
+                assert(v[i].id == static_cast<int>(i));
+            }
+
+            IncrementalVector<Obj, STEP> v_copy(v);
+            assert(!v_copy.IsMigrating());
+            assert(v_copy[SIZE - 1].id == static_cast<int>(SIZE - 1));
+
+            while (v.IsMigrating()) {
+                v.PopBack();
+            }
+            v.FinishMigration();
+            assert(v[v.Size() - 1].id == static_cast<int>(v.Size() - 1));
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        IncrementalVector<TestObj, 1, OneAndHalfGrowth> v;
+        v.Reserve(1);
+        v.EmplaceBack();
+        for (int i = 0; i < 100; ++i) {
+            // Добавление существующего элемента безопасно и во время переноса
+            v.PushBack(v[0]);
+            v.PushBack(v[v.Size() / 2]);
+        }
+        for (const TestObj& obj : v) {
+            assert(obj.IsAlive());
+        }
+    }
+}
+
+void Test16() {
+    using namespace std::literals;
+    const size_t THREADS = 8;
+    const size_t PER_THREAD = 20000;
+    {
+        ConcurrentVector<size_t, 4> v;
+        std::atomic<bool> done = false;
+
+        // Читатель параллельно обходит опубликованные элементы
+        std::thread reader([&] {
+            while (!done.load()) {
+                for (size_t i = 0, size = v.Size(); i < size; ++i) {
+                    if (v.IsPublished(i)) {
+                        assert(v[i] % PER_THREAD < PER_THREAD);
+                    }
+                }
+            }
+        });
+
+        std::vector<std::thread> writers;
+        for (size_t t = 0; t < THREADS; ++t) {
+            writers.emplace_back([&v, t] {
+                const size_t* first = nullptr;
+                for (size_t i = 0; i < PER_THREAD; ++i) {
+                    const size_t index = v.EmplaceBack(t * PER_THREAD + i);
+                    assert(v[index] == t * PER_THREAD + i);
+                    if (first == nullptr) {
+                        first = &v[index];
+                    }
+                }
+                // Элементы не перемещаются при росте
+                assert(*first == t * PER_THREAD);
+            });
+        }
+        for (std::thread& writer : writers) {
+            writer.join();
+        }
+        done = true;
+        reader.join();
+
+        assert(v.Size() == THREADS * PER_THREAD);
+        std::vector<bool> seen(THREADS * PER_THREAD);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v.IsPublished(i));
+            assert(!seen[v[i]]);
+            seen[v[i]] = true;
+        }
+    }
+    {
+        Obj::ResetCounters();
+        {
+            ConcurrentVector<Obj> v;
+            v.Reserve(100);
+            v.EmplaceBack(1);
+            Obj::default_construction_throw_countdown = 1;
+            try {
+                v.EmplaceBack();
+                assert(false && "Exception is expected");
+            } catch (const std::runtime_error&) {
+            }
+            v.EmplaceBack(3, "three"s);
+            assert(v.Size() == 3);
+            assert(v.IsPublished(0) && !v.IsPublished(1) && v.IsPublished(2));
+            assert(v[2].name == "three"s);
+            assert(!v.IsPublished(3));
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test17() {
+    const size_t SIZE = 1000;
+    {
+        Obj::ResetCounters();
+        {
+            StableVector<Obj, 4> v;
+            v.EmplaceBack(0);
+            const Obj* first = &v[0];
+            for (int i = 1; i < static_cast<int>(SIZE); ++i) {
+                // Ссылка на элемент вектора остаётся корректной при росте
+                v.PushBack(v[i - 1]);
+                v[i].id = i;
+            }
+            assert(first == &v[0]);
+            assert(Obj::num_moved == 0);
+            assert(v.Size() == SIZE);
+            for (size_t i = 0; i < SIZE; ++i) {
+                assert(v[i].id == static_cast<int>(i));
+            }
+
+            auto it = std::find_if(v.begin(), v.end(), [](const Obj& obj) {
+                return obj.id == 500;
+            });
+            assert(it - v.begin() == 500);
+            assert((it + 10)->id == 510 && it[-10].id == 490);
+
+            StableVector<Obj, 4> v_copy(v);
+            assert(v_copy.Size() == SIZE && v_copy[SIZE - 1].id == static_cast<int>(SIZE - 1));
+
+            v.Resize(10);
+            const size_t capacity = v.Capacity();
+            v.ShrinkToFit();
+            assert(v.Capacity() < capacity && v.Capacity() >= 10);
+            assert(first == &v[0]);
+
+            v = std::move(v_copy);
+            assert(v.Size() == SIZE);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        Obj::ResetCounters();
+        StableVector<Obj> v(5);
+        Obj::default_construction_throw_countdown = 1;
+        try {
+            v.Resize(10);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 5);
+        v.Clear();
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test18() {
+    struct Record {
+        int id;
+        double value;
+    };
+    const std::string path = "/tmp/mmap_vector_test_" + std::to_string(getpid());
+    const int SIZE = 10000;
+    std::remove(path.c_str());
+    {
+        MmapVector<Record> v(path);
+        assert(v.Size() == 0 && !v.IsReadOnly());
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack({i, i * 0.5});
+            // Аргумент ссылается на элемент, который переедет при росте
+            v.PushBack(v[v.Size() - 1]);
+            v.PopBack();
+        }
+        v.Flush();
+        assert(v.Size() == static_cast<size_t>(SIZE));
+        v.ShrinkToFit();
+        assert(v.Capacity() == v.Size());
+    }
+    {
+        // Повторное открытие без десериализации
+        MmapVector<Record> v(path);
+        assert(v.Size() == static_cast<size_t>(SIZE));
+        assert(v[SIZE - 1].id == SIZE - 1 && v[SIZE - 1].value == (SIZE - 1) * 0.5);
+        v.Resize(SIZE + 1);
+        assert(v[SIZE].id == 0);
+        v.PopBack();
+    }
+    {
+        const MmapVector<Record> reader1(path, MmapMode::ReadOnly);
+        MmapVector<Record> reader2(path, MmapMode::ReadOnly);
+        assert(reader1.Size() == static_cast<size_t>(SIZE) && reader2.Size() == reader1.Size());
+        assert(reader1[10].id == 10 && std::as_const(reader2)[10].id == 10);
+        try {
+            reader2.PushBack({0, 0});
+            assert(false && "Exception is expected");
+        } catch (const std::logic_error&) {
+        }
+        // Запись через изменяемый доступ отвергается до обращения к защищённой странице
+        try {
+            reader2[10].id = -1;
+            assert(false && "Exception is expected");
+        } catch (const std::logic_error&) {
+        }
+        try {
+            reader2.PopBack();
+            assert(false && "Exception is expected");
+        } catch (const std::logic_error&) {
+        }
+        try {
+            reader2.Clear();
+            assert(false && "Exception is expected");
+        } catch (const std::logic_error&) {
+        }
+        assert(reader1[10].id == 10 && reader2.Size() == static_cast<size_t>(SIZE));
+    }
+    {
+        try {
+            MmapVector<int> v(path);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+    }
+    std::remove(path.c_str());
+}
+
+struct StringCodec {
+    static constexpr bool IS_BITWISE = false;
+
+    static void Encode(std::ostream& os, const std::string& value) {
+        const uint32_t size = static_cast<uint32_t>(value.size());
+        os.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        os.write(value.data(), size);
+    }
+
+    static std::string Decode(std::istream& is) {
+        uint32_t size = 0;
+        is.read(reinterpret_cast<char*>(&size), sizeof(size));
+        std::string value(is ? size : 0, '\0');
+        is.read(value.data(), static_cast<std::streamsize>(value.size()));
+        return value;
+    }
+};
+
+// Тип без конструктора по умолчанию
+struct Name {
+    explicit Name(std::string value) : value(std::move(value)) {}
+    std::string value;
+};
+
+struct NameCodec {
+    static constexpr bool IS_BITWISE = false;
+
+    static Name Decode(std::istream& is) {return Name(StringCodec::Decode(is));}
+};
+
+void Test19() {
+    const size_t SIZE = 10000;
+    {
+        Vector<int> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        std::stringstream ss;
+        SaveVector(ss, v);
+
+        Vector<int> loaded{1, 2, 3};
+        LoadVector(ss, loaded);
+        assert(loaded.Size() == SIZE);
+        assert(std::equal(loaded.begin(), loaded.end(), v.begin()));
+    }
+    {
+        // Порционное чтение дописывает элементы в конец существующего вектора
+        Vector<double> v{0.5, 1.5, 2.5, 3.5, 4.5};
+        std::stringstream ss;
+        VectorStreamWriter<double> writer(ss, v.Size());
+        writer.Write(v.Data(), 2);
+        writer.Write(v.Data() + 2, 3);
+        assert(writer.Remaining() == 0);
+
+        Vector<double> out{-1.0};
+        VectorStreamReader<double> reader(ss);
+        assert(reader.Count() == 5);
+        assert(reader.Read(out, 2) == 2);
+        assert(out.Size() == 3 && out[2] == 1.5);
+        assert(reader.Read(out) == 3);
+        assert(reader.Remaining() == 0 && reader.Read(out) == 0);
+        assert(out.Size() == 6 && out[0] == -1.0 && out[5] == 4.5);
+    }
+    {
+        using namespace std::literals;
+        Vector<std::string> v{"alpha"s, ""s, std::string(100, 'x')};
+        std::stringstream ss;
+        SaveVector<StringCodec>(ss, v);
+        Vector<std::string> loaded;
+        LoadVector<StringCodec>(ss, loaded);
+        assert(loaded.Size() == 3 && loaded[0] == "alpha"s && loaded[1].empty() && loaded[2] == v[2]);
+
+        // Откат после ошибки кодека не требует конструктора по умолчанию
+        std::string truncated = ss.str();
+        truncated.resize(truncated.size() - 10);
+        std::stringstream truncated_ss(truncated);
+        VectorStreamReader<Name, NameCodec> reader(truncated_ss);
+        Vector<Name> names;
+        names.EmplaceBack("kept"s);
+        try {
+            reader.Read(names);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(names.Size() == 1 && names[0].value == "kept"s);
+    }
+    {
+        // Порции, прочитанные до обрыва, не остаются в векторе
+        using namespace std::literals;
+        Vector<std::string> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        std::stringstream ss;
+        SaveVector<StringCodec>(ss, v);
+        std::string truncated = ss.str();
+        truncated.resize(truncated.size() - 2);
+        std::stringstream truncated_ss(truncated);
+
+        Vector<std::string> loaded{"old"s};
+        try {
+            LoadVector<StringCodec, 4>(truncated_ss, loaded);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(loaded.Size() == 0);
+    }
+    {
+        // Заголовок с огромным числом элементов отвергается до выделения памяти
+        VectorFileHeader header = MakeVectorFileHeader<int>(uint64_t(1) << 60);
+        std::string bytes(reinterpret_cast<const char*>(&header), sizeof(header));
+        bytes.append(16, '\0');
+        for (size_t limit : {static_cast<size_t>(-1), size_t(2)}) {
+            std::stringstream ss(bytes);
+            Vector<int> loaded;
+            try {
+                LoadVector(ss, loaded, limit);
+                assert(false && "Exception is expected");
+            } catch (const std::runtime_error&) {
+            }
+            assert(loaded.Capacity() == 0);
+        }
+
+        header.count = 4;
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        std::stringstream ss(bytes);
+        Vector<int> loaded;
+        try {
+            LoadVector(ss, loaded, 3);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        std::stringstream ok(bytes);
+        LoadVector(ok, loaded, 4);
+        assert(loaded.Size() == 4);
+
+        header.count = uint64_t(1) << 40;
+        std::FILE* file = std::tmpfile();
+        const int fd = fileno(file);
+        assert(write(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)));
+        lseek(fd, 0, SEEK_SET);
+        try {
+            ReadVector(fd, loaded);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(loaded.Size() == 0);
+        std::fclose(file);
+
+        // Из канала длину узнать нельзя, поэтому память растёт порциями вместе с данными
+        int pipe_fds[2];
+        assert(pipe(pipe_fds) == 0);
+        WriteVector(pipe_fds[1], Vector<int>{1, 2, 3});
+        header.count = 1000;
+        assert(write(pipe_fds[1], &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)));
+        close(pipe_fds[1]);
+        ReadVector(pipe_fds[0], loaded);
+        assert(loaded.Size() == 3 && loaded[2] == 3);
+        try {
+            ReadVector<16>(pipe_fds[0], loaded);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(loaded.Size() == 0);
+        close(pipe_fds[0]);
+    }
+    {
+        Vector<int> v{1, 2, 3};
+        std::stringstream ss;
+        SaveVector(ss, v);
+
+        Vector<int64_t> wrong_type;
+        try {
+            std::stringstream copy(ss.str());
+            LoadVector(copy, wrong_type);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+
+        std::string truncated = ss.str();
+        truncated.pop_back();
+        std::stringstream truncated_ss(truncated);
+        Vector<int> loaded{7};
+        try {
+            LoadVector(truncated_ss, loaded);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(loaded.Size() == 0);
+    }
+    {
+        std::FILE* file = std::tmpfile();
+        const int fd = fileno(file);
+        Vector<uint64_t> v;
+        for (uint64_t i = 0; i < SIZE; ++i) {
+            v.PushBack(i * i);
+        }
+        WriteVector(fd, v);
+        lseek(fd, 0, SEEK_SET);
+
+        Vector<uint64_t> loaded;
+        ReadVector(fd, loaded);
+        assert(loaded.Size() == SIZE && loaded.Capacity() == SIZE);
+        assert(std::equal(loaded.begin(), loaded.end(), v.begin()));
+        std::fclose(file);
+    }
+}
+
+void Test20() {
+    using namespace std::literals;
+    const size_t SIZE = 1000;
+    {
+        SoAVector<int, double, char> v;
+        v.Reserve(10);
+        assert(v.Capacity() == 10);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i), i * 0.5, static_cast<char>('a' + i % 26));
+        }
+        assert(v.Size() == SIZE);
+
+        // Колонки непрерывны и выровнены по своему типу
+        auto ids = v.Column<0>();
+        auto values = v.Column<1>();
+        assert(ids.Size() == SIZE && values.Data() + SIZE == values.end());
+        assert(reinterpret_cast<uintptr_t>(values.Data()) % alignof(double) == 0);
+        long long sum = 0;
+        for (int id : ids) {
+            sum += id;
+        }
+        assert(sum == static_cast<long long>(SIZE * (SIZE - 1) / 2));
+
+        auto [id, value, letter] = v[27];
+        assert(id == 27 && value == 13.5 && letter == 'b');
+        value = -1.0;
+        assert(v.Column<1>()[27] == -1.0);
+
+        auto it = std::find_if(v.begin(), v.end(), [](const auto& row) {
+            return std::get<0>(row) == 500;
+        });
+        assert(it - v.begin() == 500);
+
+        v.Erase(1 + v.begin());
+        assert(v.Size() == SIZE - 1 && std::get<0>(v[1]) == 2 && std::get<2>(v[1]) == 'c');
+        SoAVector<int, double, char>::const_iterator first = v.begin();
+        assert(first == v.cbegin() && first <= v.begin() && v.cend() > first && v.cend() >= v.end());
+
+        SoAVector<int, double, char> v_copy(v);
+        assert(v_copy.Size() == v.Size() && std::get<0>(v_copy[SIZE - 2]) == static_cast<int>(SIZE - 1));
+        v.Erase(v.begin());
+        assert(v.Size() == SIZE - 2 && std::get<0>(v[0]) == 2);
+        v.Clear();
+        v = std::move(v_copy);
+        assert(v.Size() == SIZE - 1);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            SoAVector<std::string, Obj> v;
+            v.EmplaceBack("a"s, 1);
+            v.EmplaceBack("b"s, 2);
+
+            // Исключение при построении строки во время роста не меняет вектор
+            std::get<1>(v[0]).throw_on_copy = true;
+            try {
+                v.EmplaceBack("c"s, std::get<1>(v[0]));
+                assert(false && "Exception is expected");
+            } catch (const std::runtime_error&) {
+            }
+            assert(v.Size() == 2 && v.Capacity() == 2);
+            assert(std::get<0>(v[0]) == "a"s && std::get<1>(v[1]).id == 2);
+
+            std::get<1>(v[0]).throw_on_copy = false;
+            v.EmplaceBack(std::get<0>(v[0]), 3);
+            assert(v.Size() == 3 && std::get<0>(v[2]) == "a"s);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+// Сверяет векторные ядра с эталонными на всех уровнях, которые поддерживает процессор.
+// Значения — небольшие целые, поэтому суммы float и double точны при любом порядке сложения
+template<typename T>
+void CheckKernels() {
+    using kernels::ScalarKernels;
+    const size_t MAX_SIZE = 300;
+
+    Vector<T> a, b, c;
+    for (size_t i = 0; i < MAX_SIZE; ++i) {
+        a.PushBack(static_cast<T>(static_cast<int>(i * 7 % 23) - 11));
+        b.PushBack(static_cast<T>(static_cast<int>(i * 5 % 17) - 8));
+        c.PushBack(static_cast<T>(static_cast<int>(i % 5)));
+    }
+    // Минимум и максимум в хвосте и в середине
+    a[MAX_SIZE - 1] = static_cast<T>(-100);
+    a[MAX_SIZE / 2] = static_cast<T>(100);
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        SetSimdLevel(level);
+        for (size_t n : {size_t(0), size_t(1), size_t(3), size_t(8), size_t(17), size_t(64), size_t(151), MAX_SIZE}) {
+            // Смещение на один элемент проверяет невыровненные загрузки
+            for (size_t offset : {size_t(0), size_t(1)}) {
+                const size_t count = n > offset ? n - offset : 0;
+                const T* pa = a.Data() + offset;
+                const T* pb = b.Data() + offset;
+                const T* pc = c.Data() + offset;
+
+                assert(kernels::Sum(pa, count) == ScalarKernels::Sum(pa, count));
+                assert(kernels::Dot(pa, pb, count) == ScalarKernels::Dot(pa, pb, count));
+                if (count != 0) {
+                    assert(kernels::Min(pa, count) == ScalarKernels::Min(pa, count));
+                    assert(kernels::Max(pa, count) == ScalarKernels::Max(pa, count));
+                }
+                assert(kernels::Find(pa, count, static_cast<T>(-100)) == ScalarKernels::Find(pa, count, static_cast<T>(-100)));
+                assert(kernels::Find(pa, count, static_cast<T>(3)) == ScalarKernels::Find(pa, count, static_cast<T>(3)));
+                assert(kernels::Count(pb, count, static_cast<T>(1)) == ScalarKernels::Count(pb, count, static_cast<T>(1)));
+
+                Vector<T> expected(count), actual(count);
+                ScalarKernels::Add(pa, pb, expected.Data(), count);
+                kernels::Add(pa, pb, actual.Data(), count);
+                assert(std::equal(actual.begin(), actual.end(), expected.begin()));
+
+                ScalarKernels::Mul(pa, pb, expected.Data(), count);
+                kernels::Mul(pa, pb, actual.Data(), count);
+                assert(std::equal(actual.begin(), actual.end(), expected.begin()));
+
+                ScalarKernels::Fma(pa, pb, pc, expected.Data(), count);
+                kernels::Fma(pa, pb, pc, actual.Data(), count);
+                assert(std::equal(actual.begin(), actual.end(), expected.begin()));
+
+                ScalarKernels::ScaledCopy(pa, static_cast<T>(3), expected.Data(), count);
+                kernels::ScaledCopy(pa, static_cast<T>(3), actual.Data(), count);
+                assert(std::equal(actual.begin(), actual.end(), expected.begin()));
+
+                ScalarKernels::PrefixSum(pa, expected.Data(), count);
+                kernels::PrefixSum(pa, actual.Data(), count);
+                assert(std::equal(actual.begin(), actual.end(), expected.begin()));
+
+                // На месте
+                std::copy(pa, pa + count, actual.begin());
+                kernels::PrefixSum(actual.Data(), actual.Data(), count);
+                assert(std::equal(actual.begin(), actual.end(), expected.begin()));
+            }
+        }
+    }
+    SetSimdLevel(SimdLevel::Avx512);
+}
+
+void Test21() {
+    CheckKernels<float>();
+    CheckKernels<double>();
+    CheckKernels<int32_t>();
+    CheckKernels<int16_t>();
+    {
+        // Целочисленные ядра считают по модулю 2^32 на всех уровнях
+        Vector<int32_t> v(100);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            v[i] = INT32_MAX - static_cast<int32_t>(i);
+        }
+        const int32_t expected = kernels::ScalarKernels::Sum(v.Data(), v.Size());
+        assert(kernels::Sum(v) == expected);
+        assert(kernels::Max(v) == INT32_MAX && kernels::Min(v) == INT32_MAX - 99);
+        assert(kernels::Find(v, INT32_MAX - 42) == 42 && kernels::Count(v, 0) == 0);
+    }
+}
+
+// Счётчики атомарные: объекты строятся и разрушаются в нескольких потоках
+struct SharedCountedObj {
+    inline static std::atomic<int> alive = 0;
+    inline static std::atomic<int> throw_on_copy_of = -1;
+
+    SharedCountedObj() noexcept {++alive;}
+
+    explicit SharedCountedObj(int value) noexcept: value(value) {++alive;}
+
+    SharedCountedObj(const SharedCountedObj& other): value(other.value) {
+        if (other.value == throw_on_copy_of) {
+            throw std::runtime_error("Oops");
+        }
+        ++alive;
+    }
+
+    SharedCountedObj& operator=(const SharedCountedObj& other) = default;
+
+    ~SharedCountedObj() {--alive;}
+
+    int value = 0;
+};
+
+void Test22() {
+    const size_t SIZE = 100000;
+    {
+        ParallelVector<int, 1000> v(SIZE);
+        assert(v.Size() == SIZE && v.Capacity() == SIZE);
+        assert(std::all_of(v.begin(), v.end(), [](int x) { return x == 0; }));
+
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = static_cast<int>(i);
+        }
+        ParallelVector<int, 1000> copy(v);
+        assert(std::equal(copy.begin(), copy.end(), v.begin(), v.end()));
+
+        v.Resize(SIZE / 2);
+        v.Resize(SIZE);
+        assert(v[SIZE / 2 - 1] == static_cast<int>(SIZE / 2 - 1) && v[SIZE / 2] == 0 && v[SIZE - 1] == 0);
+
+        Vector<int> plain;
+        plain.Assign(10, 7);
+        const ParallelVector<int, 1000> from_plain(plain);
+        assert(from_plain.Size() == 10 && from_plain[9] == 7);
+    }
+    {
+        {
+            ParallelVector<SharedCountedObj, 1000> v(SIZE);
+            assert(SharedCountedObj::alive == static_cast<int>(SIZE));
+            for (size_t i = 0; i < SIZE; ++i) {
+                v[i].value = static_cast<int>(i);
+            }
+
+            ParallelVector<SharedCountedObj, 1000> target(10);
+            target[0].value = 42;
+            const SharedCountedObj* target_data = target.Data();
+
+            // Копия падает в середине: целевой вектор не меняется, построенные части разрушены
+            SharedCountedObj::throw_on_copy_of = static_cast<int>(SIZE / 2);
+            try {
+                target = v;
+                assert(false && "Exception is expected");
+            } catch (const std::runtime_error&) {
+            }
+            SharedCountedObj::throw_on_copy_of = -1;
+            assert(target.Size() == 10 && target.Data() == target_data && target[0].value == 42);
+            assert(SharedCountedObj::alive == static_cast<int>(SIZE + 10));
+
+            target = v;
+            assert(target.Size() == SIZE && target[SIZE - 1].value == static_cast<int>(SIZE - 1));
+            assert(SharedCountedObj::alive == static_cast<int>(2 * SIZE));
+
+            target.Resize(SIZE / 4);
+            assert(SharedCountedObj::alive == static_cast<int>(SIZE + SIZE / 4));
+            v.Clear();
+            assert(v.Size() == 0 && SharedCountedObj::alive == static_cast<int>(SIZE / 4));
+        }
+        assert(SharedCountedObj::alive == 0);
+    }
+}
+
+struct GrowthTag {
+    static constexpr const char* NAME = "growth";
+};
+
+struct CopyFallbackTag {
+    static constexpr const char* NAME = "copy_fallback";
+};
+
+struct InPlaceTag {
+    static constexpr const char* NAME = "in_place";
+};
+
+void Test23() {
+    VectorCounters& growth = CountersForTag<GrowthTag>();
+    growth.Reset();
+    {
+        Vector<int, Tagged<GrowthTag>> v;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(i);
+        }
+        // Вместимость 1, 2, 4, 8: три перевыделения непустого буфера
+        const VectorStats stats = growth.Snapshot();
+        assert(stats.allocations == 4 && stats.deallocations == 3);
+        assert(stats.allocated_bytes == 15 * sizeof(int) && stats.live_bytes == 8 * sizeof(int));
+        assert(stats.peak_buffer_bytes == 8 * sizeof(int) && stats.peak_live_bytes == 12 * sizeof(int));
+        assert(stats.reallocations == 3 && stats.relocated_elements == 1 + 2 + 4);
+        assert(stats.moved_elements == 0 && stats.copied_elements == 0);
+
+        Vector<int, Tagged<GrowthTag>> v_copy(v);
+        assert(growth.Snapshot().allocations == 5);
+    }
+    {
+        const VectorStats stats = growth.Snapshot();
+        assert(stats.live_bytes == 0 && stats.deallocations == 5);
+        // Три свободные ячейки в буфере на 8 элементов
+        assert(stats.wasted_bytes == 3 * sizeof(int));
+    }
+    {
+        // Перемещение может бросить, поэтому при росте элементы копируются
+        struct ThrowingMove {
+            ThrowingMove() = default;
+            ThrowingMove(const ThrowingMove&) = default;
+            ThrowingMove(ThrowingMove&&) noexcept(false) {}
+            std::string value = "value";
+        };
+        VectorCounters& copy_fallback = CountersForTag<CopyFallbackTag>();
+        copy_fallback.Reset();
+
+        Vector<ThrowingMove, Tagged<CopyFallbackTag, Align<64>>> v;
+        static_assert(decltype(v)::Alignment() == 64);
+        v.Reserve(2);
+        v.EmplaceBack();
+        v.EmplaceBack();
+        v.EmplaceBack();
+        assert(copy_fallback.Snapshot().copied_elements == 2 && copy_fallback.Snapshot().moved_elements == 0);
+
+        Vector<std::string, Tagged<CopyFallbackTag>> strings(2);
+        strings.Reserve(10);
+        assert(copy_fallback.Snapshot().moved_elements == 2);
+
+        VectorStatsRegistry::SetEnabled(false);
+        strings.Reserve(20);
+        VectorStatsRegistry::SetEnabled(true);
+        assert(copy_fallback.Snapshot().moved_elements == 2 && copy_fallback.Snapshot().reallocations == 2);
+    }
+    {
+        // Первое выделение через reallocate — не перевыделение
+        VectorCounters& in_place = CountersForTag<InPlaceTag>();
+        in_place.Reset();
+
+        Vector<int, Tagged<InPlaceTag, ReallocAllocator<int>>> v;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(i);
+        }
+        assert(in_place.Snapshot().reallocations == 3 && in_place.Snapshot().relocated_elements == 1 + 2 + 4);
+    }
+    {
+        std::ostringstream out;
+        VectorStatsRegistry::Dump(out);
+        assert(out.str().find("growth allocations=5 ") != std::string::npos);
+        assert(out.str().find("copy_fallback ") != std::string::npos);
+        assert(out.str().find("untagged ") != std::string::npos);
+    }
+}
+
+#if __cplusplus >= 202002L
+constexpr StaticVector<int, 16> MakeSquares() {
+    StaticVector<int, 16> squares;
+    for (int i = 0; squares.TryPushBack(i * i); ++i) {
+    }
+    squares.Erase(squares.begin());
+    squares.Emplace(squares.begin(), -1);
+    squares.Resize(10);
+    return squares;
+}
+#endif
+
+void Test24() {
+    using namespace std::literals;
+    static_assert(std::is_trivially_copyable_v<StaticVector<int, 4>>);
+    static_assert(!std::is_trivially_copyable_v<StaticVector<std::string, 4>>);
+#if __cplusplus >= 202002L
+    {
+        constexpr StaticVector<int, 16> squares = MakeSquares();
+        static_assert(squares.Size() == 10 && squares[0] == -1 && squares[1] == 1 && squares[9] == 81);
+    }
+#endif
+    {
+        StaticVector<int, 3> v{1, 2};
+        assert(v.TryPushBack(3) && !v.TryPushBack(4));
+        assert(v.Size() == 3 && v[2] == 3);
+        try {
+            v.PushBack(4);
+            assert(false && "Exception is expected");
+        } catch (const std::length_error&) {
+        }
+        v.Erase(v.begin());
+        v.Insert(v.begin() + 1, 5);
+        assert(v[0] == 2 && v[1] == 5 && v[2] == 3);
+
+        StaticVector<int, 3> copy = v;
+        v.Clear();
+        assert(copy.Size() == 3 && v.Size() == 0);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            StaticVector<Obj, 4> v(2);
+            v.EmplaceBack(3, "three"s);
+            // Аргумент ссылается на элемент самого вектора
+            v.Emplace(v.begin(), v[2]);
+            assert(v.Size() == 4 && v[0].id == 3 && v[1].id == 0 && v[3].id == 3);
+            assert(Obj::GetAliveObjectCount() == 4);
+
+            v.Erase(v.begin() + 1, v.begin() + 3);
+            assert(v.Size() == 2 && Obj::GetAliveObjectCount() == 2);
+
+            // Бросивший конструктор возвращает вектор к прежнему размеру
+            Obj::default_construction_throw_countdown = 2;
+            try {
+                v.Resize(4);
+                assert(false && "Exception is expected");
+            } catch (const std::runtime_error&) {
+            }
+            assert(v.Size() == 2 && Obj::GetAliveObjectCount() == 2);
+
+            StaticVector<Obj, 4> other(1);
+            other.Swap(v);
+            assert(other.Size() == 2 && v.Size() == 1 && other[1].id == 3);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test25() {
+    using namespace std::literals;
+    {
+        FlatSet<int> set{5, 1, 3};
+        assert(set.Size() == 3 && set[0] == 1 && set[2] == 5);
+        assert(!set.Insert(3).second && set.Insert(4).second);
+        assert(set.Contains(4) && !set.Contains(2) && set.Find(2) == set.end());
+        assert(*set.LowerBound(2) == 3 && set.LowerBound(6) == set.end());
+
+        // Дубликаты внутри диапазона и с имеющимися ключами
+        const std::vector<int> items{9, 0, 4, 9, 2, 0, 7};
+        set.InsertRange(items.begin(), items.end());
+        const std::vector<int> expected{0, 1, 2, 3, 4, 5, 7, 9};
+        assert(std::equal(set.begin(), set.end(), expected.begin(), expected.end()));
+
+        assert(set.Erase(3) == 1 && set.Erase(3) == 0 && set.Size() == 7);
+        set.Reserve(100);
+        assert(set.Capacity() >= 100);
+        set.ShrinkToFit();
+        assert(set.Capacity() == 7);
+    }
+    {
+        // Двоичный поиск на всех размерах и позициях
+        for (int size = 0; size < 40; ++size) {
+            FlatSet<int> set;
+            for (int i = 0; i < size; ++i) {
+                set.Insert(2 * i);
+            }
+            for (int key = -1; key <= 2 * size; ++key) {
+                const std::vector<int> keys(set.begin(), set.end());
+                assert(set.LowerBound(key) - set.begin() == std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+                assert(set.Contains(key) == (key >= 0 && key < 2 * size && key % 2 == 0));
+            }
+        }
+    }
+    {
+        FlatMap<std::string, int> map{{"b"s, 2}, {"a"s, 1}};
+        assert(map.Size() == 2 && map.Keys()[0] == "a"s && map.Values()[0] == 1);
+        map["c"s] = 3;
+        ++map["a"s];
+        assert(map.At("a"s) == 2 && map.At("c"s) == 3);
+        try {
+            map.At("z"s);
+            assert(false && "Exception is expected");
+        } catch (const std::out_of_range&) {
+        }
+
+        assert(!map.Insert("b"s, 20).second && map.At("b"s) == 2);
+
+        // Имеющиеся значения не заменяются, из повторов в диапазоне берётся первый
+        const std::vector<std::pair<std::string, int>> items{{"e"s, 5}, {"b"s, 20}, {"d"s, 4}, {"e"s, 50}};
+        map.InsertRange(items.begin(), items.end());
+        assert(map.Size() == 5);
+        std::string keys;
+        int sum = 0;
+        for (const auto& [key, value] : map) {
+            keys += key;
+            sum += value;
+        }
+        assert(keys == "abcde"s && sum == 2 + 2 + 3 + 4 + 5);
+
+        auto it = map.Find("d"s);
+        assert(it != map.end() && (*it).second == 4);
+        assert(1 + map.begin() < it && it >= map.begin() + 3 && map.end() > it && it <= map.end() - 2);
+        assert(std::lower_bound(map.begin(), map.end(), "d"s, [](const auto& entry, const std::string& key) {
+            return entry.first < key;
+        }) == it);
+        (*it).second = 40;
+        assert(map.At("d"s) == 40);
+
+        map.Erase(it);
+        assert(map.Erase("a"s) == 1 && map.Erase("a"s) == 0);
+        assert(map.Size() == 3 && !map.Contains("d"s) && map.Keys()[0] == "b"s);
+    }
+    {
+        // Ключ перемещается без исключений, а копия значения бросает: слияние копирует оба
+        struct ThrowingCopy {
+            explicit ThrowingCopy(bool throw_on_copy)
+                    : throw_on_copy(throw_on_copy) {
+            }
+            ThrowingCopy(const ThrowingCopy& other)
+                    : throw_on_copy(other.throw_on_copy) {
+                if (throw_on_copy) {
+                    throw std::runtime_error("copy");
+                }
+            }
+            ThrowingCopy& operator=(const ThrowingCopy&) = default;
+            bool throw_on_copy;
+        };
+        const std::string key = "a key longer than the small string buffer"s;
+        FlatMap<std::string, ThrowingCopy> map;
+        map.TryEmplace(key, true);
+
+        const std::vector<std::pair<std::string, ThrowingCopy>> items{{"b"s, ThrowingCopy(false)}};
+        try {
+            map.InsertRange(items.begin(), items.end());
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(map.Size() == 1 && map.Keys()[0] == key && map.Values()[0].throw_on_copy);
+    }
+}
+
+void Test26() {
+    {
+        SharedVector<int> v{1, 2, 3};
+        SharedVector<int> copy = v;
+        assert(v.UseCount() == 2 && copy.Data() == v.Data());
+
+        // Первое изменение копирует разделённый буфер, второе уже нет
+        copy.PushBack(4);
+        assert(v.UseCount() == 1 && copy.UseCount() == 1 && copy.Data() != v.Data());
+        const int* data = copy.Data();
+        copy.Mutate()[0] = 10;
+        assert(copy.Data() == data);
+        assert(v.Size() == 3 && v[0] == 1 && copy.Size() == 4 && copy[0] == 10 && copy[3] == 4);
+
+        auto snapshot = v.Snapshot();
+        assert(v.UseCount() == 2);
+        v.Erase(0);
+        v.PushBack(5);
+        assert(snapshot.Size() == 3 && snapshot[0] == 1 && snapshot[2] == 3);
+        assert(v.Size() == 3 && v[0] == 2 && v[2] == 5);
+
+        // Элемент строится из разделённого блока до того, как вектор его отпустит
+        {
+            SharedVector<std::string> names{std::string(100, 'a')};
+            auto old = names.Snapshot();
+            names.PushBack(names[0]);
+            old = VectorSnapshot<std::string>();
+            names.PushBack(names[1]);
+            assert(names.Size() == 3 && names[2] == std::string(100, 'a') && names.UseCount() == 1);
+        }
+
+        snapshot = v.Snapshot();
+        v.Clear();
+        assert(v.Size() == 0 && v.UseCount() == 0 && snapshot.Size() == 3 && snapshot[2] == 5);
+        v.Resize(2);
+        assert(v.Size() == 2 && v[1] == 0);
+    }
+    {
+        // Читатели держат снимки, пока писатель готовит следующие версии
+        SharedVector<size_t> table;
+        std::atomic<bool> done = false;
+
+        Vector<VectorSnapshot<size_t>> versions;
+        for (size_t version = 0; version < 100; ++version) {
+            table.PushBack(version);
+            versions.PushBack(table.Snapshot());
+        }
+
+        std::vector<std::thread> readers;
+        for (size_t t = 0; t < 4; ++t) {
+            readers.emplace_back([&versions, &done] {
+                while (!done.load()) {
+                    for (size_t version = 0; version < versions.Size(); ++version) {
+                        VectorSnapshot<size_t> snapshot = versions[version];
+                        assert(snapshot.Size() == version + 1);
+                        for (size_t i = 0; i < snapshot.Size(); ++i) {
+                            assert(snapshot[i] == i);
+                        }
+                    }
+                }
+            });
+        }
+
+        // Писатель меняет свою копию, не трогая снимки читателей
+        for (size_t i = 0; i < 1000; ++i) {
+            table.Mutate()[i % table.Size()] += 1000;
+            table.PushBack(i);
+        }
+        done = true;
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+        assert(table.Size() == 1100 && table[0] == 1000 && table[1099] == 999);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            SharedVector<Obj> v;
+            v.EmplaceBack(1);
+            v.EmplaceBack(2);
+            const SharedVector<Obj> copy = v;
+            assert(Obj::GetAliveObjectCount() == 2);
+            v.PopBack();
+            assert(Obj::GetAliveObjectCount() == 3 && copy.Size() == 2 && v.Size() == 1);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test27() {
+    {
+        BufferPool& pool = BufferPool::Local();
+        pool.Trim();
+        pool.ResetStats();
+
+        // Буферы одного класса размеров переиспользуются следующими векторами
+        for (int round = 0; round < 10; ++round) {
+            Vector<int, Pooled> v;
+            v.Reserve(100);
+            for (int i = 0; i < 100; ++i) {
+                v.PushBack(i);
+            }
+            assert(v[99] == 99);
+        }
+        assert(pool.Stats().misses == 1 && pool.Stats().hits == 9 && pool.Stats().recycled == 10);
+        assert(pool.CachedBytes() == BufferPool::BlockSize(100 * sizeof(int)) && BufferPool::BlockSize(400) == 512);
+
+        // Рост через удвоение проходит по классам; мелкие вместимости попадают в один класс,
+        // и старый буфер переиспользуется при следующем росте
+        pool.Trim();
+        pool.ResetStats();
+        {
+            Vector<int, Pooled> v;
+            for (int i = 0; i < 1000; ++i) {
+                v.PushBack(i);
+            }
+            Vector<int, Pooled> copy = v;
+            assert(copy.Size() == 1000 && copy[999] == 999);
+        }
+        assert(pool.Stats().hits > 0 && pool.Stats().recycled == pool.Stats().hits + pool.Stats().misses);
+
+        // Ограничение класса: лишние блоки уходят в глобальный аллокатор
+        pool.Trim();
+        pool.ResetStats();
+        pool.SetCap(64, 2);
+        {
+            Vector<Vector<int, Pooled>> many;
+            for (int i = 0; i < 5; ++i) {
+                many.EmplaceBack().Reserve(16);
+            }
+        }
+        assert(pool.Stats().recycled == 2 && pool.Stats().dropped == 3 && pool.CachedBytes() == 128);
+        pool.SetCap(64, 1);
+        assert(pool.Cap(64) == 1 && pool.CachedBytes() == 64);
+
+        // Слишком большие буферы в пул не попадают
+        {
+            Vector<char, Pooled> big;
+            big.Reserve(BufferPool::MAX_BLOCK + 1);
+        }
+        assert(pool.CachedBytes() == 64 && pool.Stats().dropped == 4);
+
+        // Размеры больше MAX_BLOCK не относятся ни к одному классу
+        pool.SetCap(BufferPool::MAX_BLOCK * 4, 3);
+        assert(pool.Cap(BufferPool::MAX_BLOCK * 4) == 0 && pool.Cap(BufferPool::MAX_BLOCK) == 1);
+
+        pool.Trim();
+        assert(pool.CachedBytes() == 0);
+        pool.ResetCaps();
+        assert(pool.Cap(64) == BufferPool::DefaultCap(64) && pool.Cap(64) == BufferPool::DEFAULT_CLASS_BUDGET / 64);
+    }
+    {
+        // У каждого потока свой пул
+        std::vector<std::thread> workers;
+        std::atomic<size_t> hits = 0;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([&hits] {
+                for (int round = 0; round < 100; ++round) {
+                    Vector<std::string, Pooled> v;
+                    v.Reserve(8);
+                    v.EmplaceBack("pooled");
+                }
+                hits += BufferPool::Local().Stats().hits;
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        assert(hits == 4 * 99);
+    }
+    {
+        // Вектор создан раньше пула потока и разрушается после него: буфер возвращается в operator delete,
+        // а не в список разрушенного пула
+        std::thread([] {
+            thread_local Vector<int, Pooled> outliving;
+            outliving.PushBack(1);
+            assert(BufferPool::Local().Stats().misses == 1);
+        }).join();
+    }
+}
+
+void Test28() {
+    {
+        BitVector<> bits;
+        for (size_t i = 0; i < 200; ++i) {
+            bits.PushBack(i % 3 == 0);
+        }
+        assert(bits.Size() == 200 && bits.Words().Size() == 4 && bits.Capacity() >= 200);
+        assert(bits[0] && !bits[1] && bits[198] && !bits[199]);
+        assert(bits.Count() == 67);
+
+        // Ссылки на биты
+        bits[1] = true;
+        bits[0] = bits[2];
+        bits[6].Flip();
+        bits.Reset(3);
+        assert(!bits[0] && bits[1] && !bits[3] && !bits[6]);
+
+        assert(bits.Rank(0) == 0 && bits.Rank(2) == 1 && bits.Rank(200) == 65);
+        assert(bits.Select(0) == 1 && bits.Select(1) == 9 && bits.Select(64) == 198 && bits.Select(65) == 200);
+        assert(bits.FindFirstSet() == 1 && bits.FindNextSet(2) == 9 && bits.FindNextSet(199) == 200);
+
+        BitRankIndex index(bits);
+        for (size_t pos = 0; pos <= bits.Size(); ++pos) {
+            assert(index.Rank(pos) == bits.Rank(pos));
+        }
+        for (size_t rank = 0; rank <= index.Count(); ++rank) {
+            assert(index.Select(rank) == bits.Select(rank));
+        }
+
+        // Лишние биты последнего слова остаются нулями
+        bits.PopBack();
+        bits.PopBack();
+        assert(bits.Size() == 198 && bits.Count() == 64);
+        bits.Resize(300, true);
+        assert(bits.Size() == 300 && bits.Count() == 166 && bits[299] && bits.Words().Size() == 5);
+        bits.Resize(100);
+        bits.Resize(130);
+        assert(bits.Rank(130) == bits.Rank(100) && bits.FindNextSet(100) == 130);
+    }
+    {
+        BitVector<> a(1000);
+        BitVector<> b(1000);
+        for (size_t i = 0; i < 1000; ++i) {
+            a.Set(i, i % 2 == 0);
+            b.Set(i, i % 3 == 0);
+        }
+
+        assert((a & b).Count() == 167);
+        assert((a | b).Count() == 667);
+        assert((a ^ b).Count() == 500);
+        BitVector<> rest = a;
+        rest.AndNot(b);
+        assert(rest.Count() == 333 && rest.FindFirstSet() == 2);
+        assert(rest != a && (rest | (a & b)) == a);
+
+        const BitVector<> literal{true, false, true};
+        assert(literal.Size() == 3 && literal.Count() == 2 && literal[2]);
+
+        // Полмиллиона битов занимают 8 КиБ, а не полмегабайта, как Vector<bool>
+        BitVector<> large(500'000, true);
+        assert(large.Words().Size() == 7813 && large.Count() == 500'000);
+        assert(BitRankIndex(large).Select(499'999) == 499'999);
+
+        const BitRankIndex empty;
+        assert(empty.Rank(0) == 0 && empty.Count() == 0 && empty.Select(0) == 0);
+        assert(BitRankIndex(BitVector<>()).Rank(0) == 0);
+    }
+}
+
+void Test29() {
+    {
+        RingVector<int> queue;
+        for (int i = 0; i < 5; ++i) {
+            queue.PushBack(i);
+        }
+        for (int i = 1; i <= 3; ++i) {
+            queue.PushFront(-i);
+        }
+        assert(queue.Size() == 8 && queue.Capacity() == 8);
+        assert(queue.Front() == -3 && queue.Back() == 4 && queue[3] == 0);
+
+        // Рост переносит оба куска кольца в начало нового буфера
+        queue.PushBack(5);
+        assert(queue.Capacity() == 16 && queue.Size() == 9);
+        assert(std::is_sorted(queue.begin(), queue.end()) && queue[0] == -3 && queue[8] == 5);
+
+        queue.PopFront();
+        queue.PopBack();
+        assert(queue.Size() == 7 && queue.Front() == -2 && queue.Back() == 4);
+        assert(queue.end() - queue.begin() == 7 && *(queue.begin() + 2) == 0);
+
+        // Очередь, которую разбирают с начала, не сдвигает элементы и не растёт
+        for (int i = 0; i < 1000; ++i) {
+            queue.PushBack(i);
+            queue.PopFront();
+        }
+        assert(queue.Size() == 7 && queue.Capacity() == 16 && queue.Front() == 993 && queue.Back() == 999);
+
+        queue.PushBack(queue.Front());
+        assert(queue.Back() == 993);
+        queue.Reserve(100);
+        assert(queue.Capacity() == 128 && queue.Size() == 8 && queue[0] == 993);
+
+        RingVector<int> copy = queue;
+        queue.Clear();
+        assert(queue.Size() == 0 && copy.Size() == 8 && copy[7] == 993);
+        const RingVector<int> literal{1, 2, 3};
+        assert(literal.Size() == 3 && literal[2] == 3);
+    }
+    {
+        // Окно последних значений: новые вытесняют самые старые
+        Deque<int> window;
+        window.SetBound(4);
+        for (int i = 0; i < 10; ++i) {
+            window.PushBack(i);
+        }
+        assert(window.Size() == 4 && window.Front() == 6 && window.Back() == 9);
+
+        window.PushFront(100);
+        assert(window.Size() == 4 && window.Front() == 100 && window.Back() == 8);
+
+        // Ограничение меньше вместимости: остаётся свободное место
+        window.SetBound(3);
+        assert(window.Size() == 3 && window.Front() == 6);
+        window.PushBack(10);
+        window.PushBack(11);
+        assert(window.Size() == 3 && window[0] == 8 && window[2] == 11);
+
+        window.SetBound(0);
+        for (int i = 0; i < 10; ++i) {
+            window.PushBack(i);
+        }
+        assert(window.Size() == 13);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            RingVector<Obj> objects;
+            objects.SetBound(5);
+            for (int i = 0; i < 20; ++i) {
+                objects.EmplaceBack(i);
+                objects.EmplaceFront(-i);
+            }
+            assert(objects.Size() == 5 && Obj::GetAliveObjectCount() == 5);
+            RingVector<Obj> copy = objects;
+            assert(Obj::GetAliveObjectCount() == 10 && copy[0].id == objects[0].id);
+
+            RingVector<Obj> grown;
+            for (int i = 0; i < 3; ++i) {
+                grown.EmplaceFront(i);
+            }
+            for (int i = 0; i < 20; ++i) {
+                grown.EmplaceBack(i);
+            }
+            assert(grown.Size() == 23 && grown[0].id == 2 && grown[22].id == 19);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
 int main() {
     try {
         Test1();
@@ -387,6 +2326,30 @@ int main() {
         Test3();
         Test4();
         Test5();
+        Test6();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
     }
@@ -0,0 +1,363 @@
+#pragma once
+
+#include "vector.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+enum class MmapMode {
+    ReadWrite,
+    // Общее отображение только для чтения: несколько процессов делят одну копию страниц в page cache
+    ReadOnly,
+};
+
+// Заголовок в начале файла. Число элементов хранится в отображённой памяти,
+// поэтому повторное открытие файла не требует десериализации.
+struct alignas(64) MmapVectorHeader {
+    static constexpr uint64_t MAGIC = 0x31524f5443455631; // "1VECTOR1"
+
+    uint64_t magic;
+    uint64_t element_size;
+    uint64_t element_alignment;
+    uint64_t size;
+};
+
+// Вектор тривиально копируемых элементов, отображённый на файл. Ёмкость — это размер файла за вычетом
+// заголовка: рост выполняется через ftruncate и mremap, запись на диск — через Flush (msync).
+// Как и у Vector, рост инвалидирует указатели на элементы.
+template<typename T, typename GrowthPolicy = DoublingGrowth>
+class MmapVector {
+    static_assert(std::is_trivially_copyable_v<T>, "MmapVector stores elements as raw file bytes");
+    static_assert(alignof(T) <= alignof(MmapVectorHeader));
+
+public:
+    using value_type = T;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    explicit MmapVector(const std::string &path, MmapMode mode = MmapMode::ReadWrite);
+
+    MmapVector(const MmapVector &) = delete;
+
+    MmapVector &operator=(const MmapVector &) = delete;
+
+    MmapVector(MmapVector &&other) noexcept;
+
+    MmapVector &operator=(MmapVector &&other) noexcept;
+
+    ~MmapVector();
+
+    // Изменяемый доступ к отображению только для чтения бросает std::logic_error, а не падает
+    // на записи в защищённую страницу. Читать такое отображение нужно через константный объект
+    iterator begin() {return Data();}
+    iterator end() {return Data() + Size();}
+    const_iterator cbegin() const noexcept {return Data();}
+    const_iterator cend() const noexcept {return Data() + Size();}
+    const_iterator begin() const noexcept {return cbegin();}
+    const_iterator end() const noexcept {return cend();}
+
+    void Reserve(size_t new_capacity);
+
+    void Resize(size_t new_size);
+
+    // Обрезает файл до занятого элементами размера
+    void ShrinkToFit();
+
+    void PushBack(const T &value);
+
+    template<typename... Args>
+    T &EmplaceBack(Args &&... args);
+
+    void PopBack();
+
+    void Clear();
+
+    // Синхронно записывает изменённые страницы и заголовок в файл
+    void Flush();
+
+    size_t Size() const noexcept {return header_->size;}
+
+    size_t Capacity() const noexcept {return capacity_;}
+
+    bool IsReadOnly() const noexcept {return mode_ == MmapMode::ReadOnly;}
+
+    T *Data();
+
+    const T *Data() const noexcept {return Elements();}
+
+    const T &operator[](size_t index) const noexcept;
+
+    T &operator[](size_t index);
+
+    void Swap(MmapVector &other) noexcept;
+
+private:
+    static constexpr size_t HEADER_SIZE = sizeof(MmapVectorHeader);
+
+    [[noreturn]] static void ThrowSystemError(const char *what);
+
+    static size_t FileSize(size_t capacity) noexcept {return HEADER_SIZE + capacity * sizeof(T);}
+
+    void CheckWritable() const;
+
+    T *Elements() const noexcept {
+        return reinterpret_cast<T *>(reinterpret_cast<unsigned char *>(header_) + HEADER_SIZE);
+    }
+
+    void ReallocateTo(size_t new_capacity);
+
+    void Unmap() noexcept;
+
+    int fd_ = -1;
+    MmapMode mode_ = MmapMode::ReadWrite;
+    MmapVectorHeader *header_ = nullptr;
+    size_t capacity_ = 0;
+};
+
+template<typename T, typename GrowthPolicy>
+void MmapVector<T, GrowthPolicy>::ThrowSystemError(const char *what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Новый файл получает заголовок с нулевым размером. У существующего файла проверяются
+// сигнатура и размер элемента, ёмкость вычисляется по длине файла.
+template<typename T, typename GrowthPolicy>
+MmapVector<T, GrowthPolicy>::MmapVector(const std::string &path, MmapMode mode)
+        : mode_(mode) {
+    const bool read_only = IsReadOnly();
+
+    fd_ = open(path.c_str(), read_only ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+
+    if (fd_ == -1) {
+        ThrowSystemError("MmapVector: open");
+    }
+
+    try {
+        struct stat st{};
+
+        if (fstat(fd_, &st) == -1) {
+            ThrowSystemError("MmapVector: fstat");
+        }
+
+        const bool is_new = st.st_size == 0;
+        size_t file_size = static_cast<size_t>(st.st_size);
+
+        if (is_new && read_only) {
+            throw std::runtime_error("MmapVector: file is empty");
+        }
+
+        if (is_new) {
+            file_size = FileSize(0);
+
+            if (ftruncate(fd_, static_cast<off_t>(file_size)) == -1) {
+                ThrowSystemError("MmapVector: ftruncate");
+            }
+        }
+
+        if (file_size < HEADER_SIZE) {
+            throw std::runtime_error("MmapVector: file is too small");
+        }
+
+        capacity_ = (file_size - HEADER_SIZE) / sizeof(T);
+        const int protection = read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        void *map = mmap(nullptr, FileSize(capacity_), protection, MAP_SHARED, fd_, 0);
+
+        if (map == MAP_FAILED) {
+            ThrowSystemError("MmapVector: mmap");
+        }
+
+        header_ = static_cast<MmapVectorHeader *>(map);
+
+        if (is_new) {
+            *header_ = MmapVectorHeader{MmapVectorHeader::MAGIC, sizeof(T), alignof(T), 0};
+        } else if (header_->magic != MmapVectorHeader::MAGIC || header_->element_size != sizeof(T)
+                   || header_->element_alignment != alignof(T) || header_->size > capacity_) {
+            throw std::runtime_error("MmapVector: file does not hold elements of this type");
+        }
+    } catch (...) {
+        Unmap();
+        throw;
+    }
+}
+
+template<typename T, typename GrowthPolicy>
+MmapVector<T, GrowthPolicy>::MmapVector(MmapVector &&other) noexcept
+        : fd_(std::exchange(other.fd_, -1)),
+          mode_(other.mode_),
+          header_(std::exchange(other.header_, nullptr)),
+          capacity_(std::exchange(other.capacity_, 0)) {
+}
+
+template<typename T, typename GrowthPolicy>
+MmapVector<T, GrowthPolicy> &MmapVector<T, GrowthPolicy>::operator=(MmapVector &&other) noexcept {
+    Swap(other);
+    return *this;
+}
+
+// Данные остаются в page cache и попадут в файл и без Flush, но без гарантии на случай сбоя системы
+template<typename T, typename GrowthPolicy>
+MmapVector<T, GrowthPolicy>::~MmapVector() {
+    Unmap();
+}
+
+template<typename T, typename GrowthPolicy>
+void MmapVector<T, GrowthPolicy>::Unmap() noexcept {
+
+    if (header_ != nullptr) {
+        munmap(header_, FileSize(capacity_));
+        header_ = nullptr;
+    }
+
+    if (fd_ != -1) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+template<typename T, typename GrowthPolicy>
+void MmapVector<T, GrowthPolicy>::Swap(MmapVector &other) noexcept {
+    std::swap(fd_, other.fd_);
+    std::swap(mode_, other.mode_);
+    std::swap(header_, other.header_);
+    std::swap(capacity_, other.capacity_);
+}
+
+template<typename T, typename GrowthPolicy>
+void MmapVector<T, GrowthPolicy>::CheckWritable() const {
+
+    if (IsReadOnly()) {
+        throw std::logic_error("MmapVector: modification of a read-only mapping");
+    }
+}
+
+template<typename T, typename GrowthPolicy>
+T *MmapVector<T, GrowthPolicy>::Data() {
+    CheckWritable();
+    return Elements();
+}
+
+template<typename T, typename GrowthPolicy>
+T &MmapVector<T, GrowthPolicy>::operator[](size_t index) {
+    assert(index < Size());
+    CheckWritable();
+    return Elements()[index];
+}
+
+template<typename T, typename GrowthPolicy>
+const T &MmapVector<T, GrowthPolicy>::operator[](size_t index) const noexcept {
+    assert(index < Size());
+    return Data()[index];
+}
+
+// Файл сначала меняет длину, затем отображение. Если mremap не удался, отображение и ёмкость остаются прежними,
+// а лишняя длина файла лишь увеличит ёмкость при следующем открытии
+template<typename T, typename GrowthPolicy>
+void MmapVector<T, GrowthPolicy>::ReallocateTo(size_t new_capacity) {
+    CheckWritable();
+
+    if (new_capacity > (static_cast<size_t>(-1) - HEADER_SIZE) / sizeof(T)) {
+        throw std::bad_array_new_length();
+    }
+
+    const size_t old_size = FileSize(capacity_);
+    const size_t new_size = FileSize(new_capacity);
+
+    if (ftruncate(fd_, static_cast<off_t>(new_size)) == -1) {
+        ThrowSystemError("MmapVector: ftruncate");
+    }
+
+#ifdef __linux__
+    void *map = mremap(header_, old_size, new_size, MREMAP_MAYMOVE);
+#else
+    void *map = mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+#endif
+
+    if (map == MAP_FAILED) {
+        ThrowSystemError("MmapVector: mremap");
+    }
+
+#ifndef __linux__
+    munmap(header_, old_size);
+#endif
+
+    header_ = static_cast<MmapVectorHeader *>(map);
+    capacity_ = new_capacity;
+}
+
+template<typename T, typename GrowthPolicy>
+void MmapVector<T, GrowthPolicy>::Reserve(size_t new_capacity) {
+
+    if (new_capacity > capacity_) {
+        ReallocateTo(new_capacity);
+    }
+}
+
+template<typename T, typename GrowthPolicy>
+void MmapVector<T, GrowthPolicy>::Resize(size_t new_size) {
+    CheckWritable();
+    Reserve(new_size);
+
+    if (new_size > Size()) {
+        std::uninitialized_value_construct_n(Elements() + Size(), new_size - Size());
+    }
+
+    header_->size = new_size;
+}
+
+template<typename T, typename GrowthPolicy>
+void MmapVector<T, GrowthPolicy>::ShrinkToFit() {
+
+    if (capacity_ > Size()) {
+        ReallocateTo(Size());
+    }
+}
+
+template<typename T, typename GrowthPolicy>
+void MmapVector<T, GrowthPolicy>::PushBack(const T &value) {
+    EmplaceBack(value);
+}
+
+// Элемент строится до роста: аргументы могут ссылаться на элементы, которые mremap переместит
+template<typename T, typename GrowthPolicy>
+template<typename... Args>
+T &MmapVector<T, GrowthPolicy>::EmplaceBack(Args &&... args) {
+    CheckWritable();
+
+    if (Size() == capacity_) {
+        T value(std::forward<Args>(args)...);
+        ReallocateTo(GrowthPolicy::NextCapacity(capacity_, Size() + 1, sizeof(T)));
+        return *new (Elements() + header_->size++) T(value);
+    }
+
+    return *new (Elements() + header_->size++) T(std::forward<Args>(args)...);
+}
+
+template<typename T, typename GrowthPolicy>
+void MmapVector<T, GrowthPolicy>::PopBack() {
+    CheckWritable();
+    assert(Size());
+    --header_->size;
+}
+
+template<typename T, typename GrowthPolicy>
+void MmapVector<T, GrowthPolicy>::Clear() {
+    CheckWritable();
+    header_->size = 0;
+}
+
+template<typename T, typename GrowthPolicy>
+void MmapVector<T, GrowthPolicy>::Flush() {
+
+    if (!IsReadOnly() && msync(header_, FileSize(capacity_), MS_SYNC) == -1) {
+        ThrowSystemError("MmapVector: msync");
+    }
+}
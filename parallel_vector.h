@@ -0,0 +1,253 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <thread>
+
+// Делит [0, count) на части не меньше min_chunk элементов и выполняет op(begin, n) для каждой части
+// в отдельном потоке, последнюю часть — в вызывающем. Возвращает число частей; failures[i]
+// содержит исключение i-й части или пустой указатель.
+template<typename Operation>
+size_t ParallelChunks(size_t count, size_t min_chunk, Vector<std::exception_ptr> &failures, Operation op) {
+    const size_t hardware = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t chunks = std::max<size_t>(std::min(hardware, count / std::max<size_t>(min_chunk, 1)), 1);
+
+    failures.Assign(chunks, std::exception_ptr());
+
+    auto run = [&](size_t chunk) {
+        const size_t begin = count * chunk / chunks;
+        const size_t end = count * (chunk + 1) / chunks;
+
+        try {
+            op(begin, end - begin);
+        } catch (...) {
+            failures[chunk] = std::current_exception();
+        }
+    };
+
+    Vector<std::thread> workers;
+    workers.Reserve(chunks - 1);
+
+    // Если поток не удалось запустить, его часть выполняется в вызывающем потоке
+    size_t chunk = 0;
+    try {
+        for (; chunk + 1 < chunks; ++chunk) {
+            workers.EmplaceBack(run, chunk);
+        }
+    } catch (...) {
+        for (; chunk + 1 < chunks; ++chunk) {
+            run(chunk);
+        }
+    }
+
+    run(chunks - 1);
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    return chunks;
+}
+
+template<typename T>
+void ParallelDestroyN(T *first, size_t count, size_t min_chunk) noexcept {
+
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+
+        if (count < 2 * min_chunk) {
+            std::destroy_n(first, count);
+            return;
+        }
+
+        try {
+            Vector<std::exception_ptr> failures;
+            ParallelChunks(count, min_chunk, failures, [first](size_t begin, size_t n) {
+                std::destroy_n(first + begin, n);
+            });
+        } catch (...) {
+            // Не удалось выделить память под служебные структуры: разрушаем в текущем потоке
+            std::destroy_n(first, count);
+        }
+    }
+}
+
+// Строит count элементов в dest по частям; construct(begin, n) строит элементы [begin, begin + n) и при исключении
+// сам разрушает построенное в своей части. Если бросила хоть одна часть, остальные части разрушаются,
+// а первое исключение пробрасывается дальше: в dest не остаётся построенных элементов.
+template<typename T, typename Construct>
+void ParallelUninitializedN(T *dest, size_t count, size_t min_chunk, Construct construct) {
+
+    if (count < 2 * min_chunk) {
+        construct(0, count);
+        return;
+    }
+
+    Vector<std::exception_ptr> failures;
+    const size_t chunks = ParallelChunks(count, min_chunk, failures, construct);
+
+    const auto failed = std::find_if(failures.begin(), failures.end(), [](const std::exception_ptr &failure) {
+        return failure != nullptr;
+    });
+
+    if (failed != failures.end()) {
+
+        for (size_t chunk = 0; chunk != chunks; ++chunk) {
+
+            if (failures[chunk] == nullptr) {
+                const size_t begin = count * chunk / chunks;
+                const size_t end = count * (chunk + 1) / chunks;
+                std::destroy_n(dest + begin, end - begin);
+            }
+        }
+
+        std::rethrow_exception(*failed);
+    }
+}
+
+// Вектор, который строит, копирует и разрушает элементы в нескольких потоках, если их не меньше 2 * MinChunk.
+// Параллельное заполнение свежевыделенного буфера заодно распределяет его страницы по NUMA-узлам потоков.
+// Исключение в любой части откатывает всю операцию: построенные части разрушаются, вектор не меняется.
+// Остальные операции совпадают с Vector.
+template<typename T, size_t MinChunk = (size_t(1) << 16), typename Allocator = std::allocator<T>,
+         typename GrowthPolicy = DoublingGrowth>
+class ParallelVector : private Vector<T, Allocator, GrowthPolicy> {
+    static_assert(MinChunk > 0);
+    static_assert(UsesPlacementConstructV<AllocatorForT<T, Allocator>, T>,
+                  "elements are constructed without allocator_traits::construct");
+
+    using Base = Vector<T, Allocator, GrowthPolicy>;
+
+public:
+    using typename Base::value_type;
+    using typename Base::allocator_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+
+    ParallelVector() = default;
+
+    explicit ParallelVector(size_t size, const allocator_type &alloc = allocator_type());
+
+    explicit ParallelVector(const Base &other);
+
+    ParallelVector(const ParallelVector &other);
+
+    ParallelVector(ParallelVector &&other) noexcept = default;
+
+    ParallelVector &operator=(const ParallelVector &other);
+
+    ParallelVector &operator=(ParallelVector &&other) = default;
+
+    ~ParallelVector();
+
+    using Base::begin;
+    using Base::end;
+    using Base::cbegin;
+    using Base::cend;
+
+    using Base::Reserve;
+    using Base::ShrinkToFit;
+    using Base::PushBack;
+    using Base::EmplaceBack;
+    using Base::PopBack;
+    using Base::Emplace;
+    using Base::Insert;
+    using Base::Erase;
+    using Base::EraseIf;
+    using Base::UnorderedErase;
+    using Base::Append;
+    using Base::Assign;
+
+    using Base::Size;
+    using Base::Capacity;
+    using Base::Data;
+    using Base::GetAllocator;
+    using Base::operator[];
+
+    // Новые элементы инициализируются значением параллельно, лишние разрушаются параллельно
+    void Resize(size_t new_size);
+
+    void Clear() noexcept;
+
+    void Swap(ParallelVector &other) noexcept {Base::Swap(other);}
+
+    const Base &AsVector() const noexcept {return *this;}
+
+private:
+    template<typename InputIt>
+    void AppendCopies(InputIt first, size_t count);
+};
+
+template<typename T, size_t MinChunk, typename Allocator, typename GrowthPolicy>
+ParallelVector<T, MinChunk, Allocator, GrowthPolicy>::ParallelVector(size_t size, const allocator_type &alloc)
+        : Base(alloc) {
+    Base::Reserve(size);
+    Resize(size);
+}
+
+template<typename T, size_t MinChunk, typename Allocator, typename GrowthPolicy>
+ParallelVector<T, MinChunk, Allocator, GrowthPolicy>::ParallelVector(const Base &other)
+        : Base(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.GetAllocator())) {
+    AppendCopies(other.Data(), other.Size());
+}
+
+template<typename T, size_t MinChunk, typename Allocator, typename GrowthPolicy>
+ParallelVector<T, MinChunk, Allocator, GrowthPolicy>::ParallelVector(const ParallelVector &other)
+        : ParallelVector(other.AsVector()) {
+}
+
+// Копия строится целиком до обмена, поэтому исключение оставляет вектор прежним
+template<typename T, size_t MinChunk, typename Allocator, typename GrowthPolicy>
+ParallelVector<T, MinChunk, Allocator, GrowthPolicy> &ParallelVector<T, MinChunk, Allocator, GrowthPolicy>::operator=(
+        const ParallelVector &other) {
+
+    if (this != &other) {
+        ParallelVector other_copy(other);
+        Swap(other_copy);
+    }
+
+    return *this;
+}
+
+template<typename T, size_t MinChunk, typename Allocator, typename GrowthPolicy>
+ParallelVector<T, MinChunk, Allocator, GrowthPolicy>::~ParallelVector() {
+    Clear();
+}
+
+template<typename T, size_t MinChunk, typename Allocator, typename GrowthPolicy>
+template<typename InputIt>
+void ParallelVector<T, MinChunk, Allocator, GrowthPolicy>::AppendCopies(InputIt first, size_t count) {
+    Base::Reserve(Size() + count);
+
+    Base::AppendUninitialized(count, [first](T *dest, size_t n) {
+        ParallelUninitializedN(dest, n, MinChunk, [first, dest](size_t begin, size_t chunk) {
+            std::uninitialized_copy_n(first + begin, chunk, dest + begin);
+        });
+    });
+}
+
+template<typename T, size_t MinChunk, typename Allocator, typename GrowthPolicy>
+void ParallelVector<T, MinChunk, Allocator, GrowthPolicy>::Resize(size_t new_size) {
+
+    if (new_size < Size()) {
+        Base::TruncateWith(new_size, [](T *first, size_t n) {
+            ParallelDestroyN(first, n, MinChunk);
+        });
+
+    } else {
+        Base::AppendUninitialized(new_size - Size(), [](T *dest, size_t n) {
+            ParallelUninitializedN(dest, n, MinChunk, [dest](size_t begin, size_t chunk) {
+                std::uninitialized_value_construct_n(dest + begin, chunk);
+            });
+        });
+    }
+}
+
+template<typename T, size_t MinChunk, typename Allocator, typename GrowthPolicy>
+void ParallelVector<T, MinChunk, Allocator, GrowthPolicy>::Clear() noexcept {
+    Base::TruncateWith(0, [](T *first, size_t n) {
+        ParallelDestroyN(first, n, MinChunk);
+    });
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Аллокатор, который умеет расширять буфер без копирования: небольшие буферы берутся из malloc
+// и растут через realloc, буферы от MmapThreshold байт отображаются через mmap и растут через mremap.
+// Vector использует reallocate только для тривиально перемещаемых типов.
+template<typename T, size_t MmapThreshold = (size_t(64) << 20)>
+class ReallocAllocator {
+public:
+    static_assert(alignof(T) <= alignof(std::max_align_t));
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template<typename U>
+    struct rebind {
+        using other = ReallocAllocator<U, MmapThreshold>;
+    };
+
+    ReallocAllocator() = default;
+
+    template<typename U>
+    ReallocAllocator(const ReallocAllocator<U, MmapThreshold> &) noexcept {}
+
+    T *allocate(size_t n);
+
+    void deallocate(T *buf, size_t n) noexcept;
+
+    T *reallocate(T *buf, size_t old_n, size_t new_n);
+
+    bool operator==(const ReallocAllocator &) const noexcept {return true;}
+
+    bool operator!=(const ReallocAllocator &) const noexcept {return false;}
+
+private:
+    static bool IsMapped(size_t bytes) noexcept;
+
+    static size_t RoundToPages(size_t bytes) noexcept;
+};
+
+template<typename T, size_t MmapThreshold>
+bool ReallocAllocator<T, MmapThreshold>::IsMapped(size_t bytes) noexcept {
+#ifdef __linux__
+    return bytes >= MmapThreshold;
+#else
+    return false;
+#endif
+}
+
+template<typename T, size_t MmapThreshold>
+size_t ReallocAllocator<T, MmapThreshold>::RoundToPages(size_t bytes) noexcept {
+#ifdef __linux__
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return (bytes + page_size - 1) / page_size * page_size;
+#else
+    return bytes;
+#endif
+}
+
+template<typename T, size_t MmapThreshold>
+T *ReallocAllocator<T, MmapThreshold>::allocate(size_t n) {
+
+    if (n > static_cast<size_t>(-1) / sizeof(T)) {
+        throw std::bad_array_new_length();
+    }
+
+    const size_t bytes = n * sizeof(T);
+    void *buf = nullptr;
+
+#ifdef __linux__
+    if (IsMapped(bytes)) {
+        buf = mmap(nullptr, RoundToPages(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        buf = buf == MAP_FAILED ? nullptr : buf;
+    } else {
+        buf = std::malloc(bytes);
+    }
+#else
+    buf = std::malloc(bytes);
+#endif
+
+    if (buf == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return static_cast<T *>(buf);
+}
+
+template<typename T, size_t MmapThreshold>
+void ReallocAllocator<T, MmapThreshold>::deallocate(T *buf, size_t n) noexcept {
+#ifdef __linux__
+    if (IsMapped(n * sizeof(T))) {
+        munmap(buf, RoundToPages(n * sizeof(T)));
+        return;
+    }
+#endif
+    std::free(buf);
+}
+
+// Возвращает буфер на new_n элементов с прежним содержимым (первые min(old_n, new_n) элементов),
+// старый буфер после этого недействителен. При ошибке старый буфер не меняется.
+template<typename T, size_t MmapThreshold>
+T *ReallocAllocator<T, MmapThreshold>::reallocate(T *buf, size_t old_n, size_t new_n) {
+
+    if (buf == nullptr) {
+        return allocate(new_n);
+    }
+
+    if (new_n > static_cast<size_t>(-1) / sizeof(T)) {
+        throw std::bad_array_new_length();
+    }
+
+    const size_t old_bytes = old_n * sizeof(T);
+    const size_t new_bytes = new_n * sizeof(T);
+
+#ifdef __linux__
+    if (IsMapped(old_bytes) && IsMapped(new_bytes)) {
+
+        if (RoundToPages(old_bytes) == RoundToPages(new_bytes)) {
+            return buf;
+        }
+
+        void *new_buf = mremap(buf, RoundToPages(old_bytes), RoundToPages(new_bytes), MREMAP_MAYMOVE);
+
+        if (new_buf == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T *>(new_buf);
+    }
+
+    if (IsMapped(old_bytes) || IsMapped(new_bytes)) {
+        T *new_buf = allocate(new_n);
+        std::memcpy(static_cast<void *>(new_buf), static_cast<const void *>(buf), std::min(old_bytes, new_bytes));
+        deallocate(buf, old_n);
+        return new_buf;
+    }
+#endif
+
+    void *new_buf = std::realloc(buf, new_bytes);
+
+    if (new_buf == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return static_cast<T *>(new_buf);
+}
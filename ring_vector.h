@@ -0,0 +1,336 @@
+#pragma once
+
+#include "vector.h"
+#include "geometric_segments.h"
+#include "index_iterator.h"
+
+// Двусторонняя очередь в одном кольцевом буфере. Вместимость — степень двойки, поэтому позиция
+// элемента находится маской, без деления. Добавление и удаление с обоих концов — O(1),
+// при росте оба куска кольца переносятся в начало нового буфера двумя блочными копированиями.
+// С ограничением (SetBound) заполненная очередь не растёт, а вытесняет самый старый элемент.
+template<typename T, typename Allocator = std::allocator<T>>
+class RingVector {
+public:
+    using value_type = T;
+    using iterator = IndexIterator<RingVector, T>;
+    using const_iterator = IndexIterator<const RingVector, const T>;
+
+    static constexpr size_t MIN_CAPACITY = 8;
+
+    RingVector() = default;
+
+    RingVector(std::initializer_list<T> items);
+
+    RingVector(const RingVector &other);
+
+    RingVector(RingVector &&other) noexcept;
+
+    RingVector &operator=(const RingVector &other);
+
+    RingVector &operator=(RingVector &&other) noexcept;
+
+    ~RingVector() {DestroyFront(size_);}
+
+    iterator begin() noexcept {return iterator(this, 0);}
+    iterator end() noexcept {return iterator(this, size_);}
+    const_iterator cbegin() const noexcept {return const_iterator(this, 0);}
+    const_iterator cend() const noexcept {return const_iterator(this, size_);}
+    const_iterator begin() const noexcept {return cbegin();}
+    const_iterator end() const noexcept {return cend();}
+
+    size_t Size() const noexcept {return size_;}
+
+    size_t Capacity() const noexcept {return data_.Capacity();}
+
+    // Вместимость округляется вверх до степени двойки
+    void Reserve(size_t new_capacity);
+
+    // Не больше max_size элементов: лишние самые старые удаляются сразу, а дальше PushBack в заполненную
+    // очередь вытесняет первый элемент, PushFront — последний. 0 снимает ограничение
+    void SetBound(size_t max_size);
+
+    size_t Bound() const noexcept {return bound_;}
+
+    T &operator[](size_t index) noexcept {
+        assert(index < size_);
+        return data_[Slot(index)];
+    }
+
+    const T &operator[](size_t index) const noexcept {return const_cast<RingVector &>(*this)[index];}
+
+    T &Front() noexcept {return (*this)[0];}
+    const T &Front() const noexcept {return (*this)[0];}
+    T &Back() noexcept {return (*this)[size_ - 1];}
+    const T &Back() const noexcept {return (*this)[size_ - 1];}
+
+    template <typename Type>
+    void PushBack(Type&& value) {EmplaceBack(std::forward<Type>(value));}
+
+    template <typename Type>
+    void PushFront(Type&& value) {EmplaceFront(std::forward<Type>(value));}
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+
+    template <typename... Args>
+    T& EmplaceFront(Args&&... args);
+
+    void PopBack() noexcept;
+
+    void PopFront() noexcept;
+
+    void Clear() noexcept {
+        DestroyFront(size_);
+        head_ = 0;
+    }
+
+    void Swap(RingVector &other) noexcept;
+
+private:
+    static size_t RoundUpToPowerOfTwo(size_t n) noexcept {
+        return n <= 1 ? 1 : size_t(1) << (Log2(n - 1) + 1);
+    }
+
+    size_t Slot(size_t index) const noexcept {return (head_ + index) & (data_.Capacity() - 1);}
+
+    // Разрушает count первых элементов
+    void DestroyFront(size_t count) noexcept;
+
+    // Переносит элементы в новый буфер на new_capacity элементов, первый элемент оказывается в начале
+    void Reallocate(size_t new_capacity);
+
+    template <typename... Args>
+    T& OverwriteBack(Args&&... args);
+
+    template <typename... Args>
+    T& OverwriteFront(Args&&... args);
+
+    RawMemory<T, Allocator> data_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+    size_t bound_ = 0;
+};
+
+template<typename T, typename Allocator = std::allocator<T>>
+using Deque = RingVector<T, Allocator>;
+
+template<typename T, typename Allocator>
+RingVector<T, Allocator>::RingVector(std::initializer_list<T> items) {
+    Reserve(items.size());
+
+    for (const T &item : items) {
+        EmplaceBack(item);
+    }
+}
+
+// Копия собирается подряд с начала буфера
+template<typename T, typename Allocator>
+RingVector<T, Allocator>::RingVector(const RingVector &other)
+        : data_(other.size_ != 0 ? RoundUpToPowerOfTwo(std::max(other.size_, MIN_CAPACITY)) : 0,
+                other.data_.GetAllocator()),
+          bound_(other.bound_) {
+
+    for (; size_ != other.size_; ++size_) {
+        try {
+            new (data_ + size_) T(other[size_]);
+        } catch (...) {
+            std::destroy_n(data_.GetAddress(), size_);
+            throw;
+        }
+    }
+}
+
+template<typename T, typename Allocator>
+RingVector<T, Allocator>::RingVector(RingVector &&other) noexcept
+        : data_(std::move(other.data_)),
+          head_(std::exchange(other.head_, 0)),
+          size_(std::exchange(other.size_, 0)),
+          bound_(other.bound_) {
+}
+
+template<typename T, typename Allocator>
+RingVector<T, Allocator> &RingVector<T, Allocator>::operator=(const RingVector &other) {
+
+    if (this != &other) {
+        RingVector other_copy(other);
+        Swap(other_copy);
+    }
+
+    return *this;
+}
+
+template<typename T, typename Allocator>
+RingVector<T, Allocator> &RingVector<T, Allocator>::operator=(RingVector &&other) noexcept {
+    Swap(other);
+    return *this;
+}
+
+template<typename T, typename Allocator>
+void RingVector<T, Allocator>::Swap(RingVector &other) noexcept {
+    data_.Swap(other.data_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+    std::swap(bound_, other.bound_);
+}
+
+template<typename T, typename Allocator>
+void RingVector<T, Allocator>::Reserve(size_t new_capacity) {
+
+    if (new_capacity > data_.Capacity()) {
+        Reallocate(RoundUpToPowerOfTwo(new_capacity));
+    }
+}
+
+template<typename T, typename Allocator>
+void RingVector<T, Allocator>::SetBound(size_t max_size) {
+
+    if (max_size != 0 && size_ > max_size) {
+        DestroyFront(size_ - max_size);
+    }
+
+    bound_ = max_size;
+    Reserve(max_size);
+}
+
+template<typename T, typename Allocator>
+void RingVector<T, Allocator>::DestroyFront(size_t count) noexcept {
+
+    for (; count != 0; --count) {
+        PopFront();
+    }
+}
+
+// Кольцо состоит из двух кусков: от head_ до конца буфера и от начала буфера. Если T нельзя
+// переносить без исключений, оба куска сначала копируются, и старые элементы разрушаются только после
+// успешного копирования, так что при ошибке очередь не меняется
+template<typename T, typename Allocator>
+void RingVector<T, Allocator>::Reallocate(size_t new_capacity) {
+    assert(new_capacity >= size_);
+    RawMemory<T, Allocator> new_data(new_capacity, data_.GetAllocator());
+
+    T *first = data_.GetAddress() + head_;
+    const size_t first_count = std::min(size_, data_.Capacity() - head_);
+    T *second = data_.GetAddress();
+    const size_t second_count = size_ - first_count;
+
+    if constexpr (IsTriviallyRelocatableV<T> || std::is_nothrow_move_constructible_v<T>
+                  || !std::is_copy_constructible_v<T>) {
+        UninitializedRelocateN(first, first_count, new_data.GetAddress());
+        UninitializedRelocateN(second, second_count, new_data.GetAddress() + first_count);
+    } else {
+        std::uninitialized_copy_n(first, first_count, new_data.GetAddress());
+
+        try {
+            std::uninitialized_copy_n(second, second_count, new_data.GetAddress() + first_count);
+        } catch (...) {
+            std::destroy_n(new_data.GetAddress(), first_count);
+            throw;
+        }
+
+        std::destroy_n(first, first_count);
+        std::destroy_n(second, second_count);
+    }
+
+    data_.Swap(new_data);
+    head_ = 0;
+}
+
+// Элемент строится до роста, так как аргументы могут ссылаться на элементы очереди
+template<typename T, typename Allocator>
+template<typename... Args>
+T &RingVector<T, Allocator>::EmplaceBack(Args&&... args) {
+
+    if (bound_ != 0 && size_ == bound_) {
+        return OverwriteBack(std::forward<Args>(args)...);
+    }
+
+    if (size_ == data_.Capacity()) {
+        T item(std::forward<Args>(args)...);
+        Reallocate(std::max(data_.Capacity() * 2, MIN_CAPACITY));
+        return EmplaceBack(std::move(item));
+    }
+
+    T *slot = data_ + Slot(size_);
+    new (slot) T(std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+T &RingVector<T, Allocator>::EmplaceFront(Args&&... args) {
+
+    if (bound_ != 0 && size_ == bound_) {
+        return OverwriteFront(std::forward<Args>(args)...);
+    }
+
+    if (size_ == data_.Capacity()) {
+        T item(std::forward<Args>(args)...);
+        Reallocate(std::max(data_.Capacity() * 2, MIN_CAPACITY));
+        return EmplaceFront(std::move(item));
+    }
+
+    const size_t new_head = (head_ - 1) & (data_.Capacity() - 1);
+    T *slot = data_ + new_head;
+    new (slot) T(std::forward<Args>(args)...);
+    head_ = new_head;
+    ++size_;
+    return *slot;
+}
+
+// Если в буфере есть свободное место, новый элемент строится в нём и только потом вытесняется старый.
+// Если буфер заполнен целиком, новый элемент присваивается на место первого, и кольцо сдвигается
+template<typename T, typename Allocator>
+template<typename... Args>
+T &RingVector<T, Allocator>::OverwriteBack(Args&&... args) {
+
+    if (size_ == data_.Capacity()) {
+        T item(std::forward<Args>(args)...);
+        T &slot = data_[head_];
+        slot = std::move(item);
+        head_ = Slot(1);
+        return slot;
+    }
+
+    T *slot = data_ + Slot(size_);
+    new (slot) T(std::forward<Args>(args)...);
+    ++size_;
+    PopFront();
+    return *slot;
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+T &RingVector<T, Allocator>::OverwriteFront(Args&&... args) {
+    const size_t new_head = (head_ - 1) & (data_.Capacity() - 1);
+
+    if (size_ == data_.Capacity()) {
+        T item(std::forward<Args>(args)...);
+        T &slot = data_[new_head];
+        slot = std::move(item);
+        head_ = new_head;
+        return slot;
+    }
+
+    T *slot = data_ + new_head;
+    new (slot) T(std::forward<Args>(args)...);
+    head_ = new_head;
+    ++size_;
+    PopBack();
+    return *slot;
+}
+
+template<typename T, typename Allocator>
+void RingVector<T, Allocator>::PopBack() noexcept {
+    assert(size_);
+    std::destroy_at(data_ + Slot(size_ - 1));
+    --size_;
+}
+
+template<typename T, typename Allocator>
+void RingVector<T, Allocator>::PopFront() noexcept {
+    assert(size_);
+    std::destroy_at(data_ + head_);
+    head_ = Slot(1);
+    --size_;
+}
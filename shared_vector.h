@@ -0,0 +1,278 @@
+#pragma once
+
+#include "vector.h"
+
+#include <atomic>
+#include <utility>
+
+namespace shared_vector_detail {
+
+    // Вектор вместе со счётчиком ссылок на него
+    template<typename VectorType>
+    struct Block {
+        explicit Block(VectorType &&items) noexcept
+                : items(std::move(items)) {
+        }
+
+        std::atomic<size_t> references{1};
+        VectorType items;
+    };
+
+    template<typename VectorType>
+    Block<VectorType> *Acquire(Block<VectorType> *block) noexcept {
+
+        if (block != nullptr) {
+            block->references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return block;
+    }
+
+    // Последний владелец удаляет блок; acq_rel гарантирует, что все чтения других владельцев
+    // завершились до разрушения элементов
+    template<typename VectorType>
+    void Release(Block<VectorType> *block) noexcept {
+
+        if (block != nullptr && block->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete block;
+        }
+    }
+
+} // namespace shared_vector_detail
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+class SharedVector;
+
+// Неизменяемый вид на версию SharedVector. Пока снимок жив, его элементы не меняются и не разрушаются:
+// писатель при следующем изменении скопирует данные. Копирование снимка — один атомарный инкремент,
+// снимки можно передавать в другие потоки и читать одновременно.
+template<typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class VectorSnapshot {
+public:
+    using value_type = T;
+    using iterator = const T*;
+    using const_iterator = const T*;
+
+    VectorSnapshot() = default;
+
+    VectorSnapshot(const VectorSnapshot &other) noexcept
+            : block_(shared_vector_detail::Acquire(other.block_)) {
+    }
+
+    VectorSnapshot(VectorSnapshot &&other) noexcept
+            : block_(std::exchange(other.block_, nullptr)) {
+    }
+
+    VectorSnapshot &operator=(VectorSnapshot other) noexcept {
+        std::swap(block_, other.block_);
+        return *this;
+    }
+
+    ~VectorSnapshot() {shared_vector_detail::Release(block_);}
+
+    const_iterator begin() const noexcept {return Data();}
+    const_iterator end() const noexcept {return Data() + Size();}
+    const_iterator cbegin() const noexcept {return begin();}
+    const_iterator cend() const noexcept {return end();}
+
+    const T *Data() const noexcept {return block_ != nullptr ? block_->items.Data() : nullptr;}
+
+    size_t Size() const noexcept {return block_ != nullptr ? block_->items.Size() : 0;}
+
+    const T &operator[](size_t index) const noexcept {
+        assert(index < Size());
+        return Data()[index];
+    }
+
+private:
+    friend class SharedVector<T, Allocator, GrowthPolicy>;
+
+    using Block = shared_vector_detail::Block<Vector<T, Allocator, GrowthPolicy>>;
+
+    explicit VectorSnapshot(Block *block) noexcept
+            : block_(shared_vector_detail::Acquire(block)) {
+    }
+
+    Block *block_ = nullptr;
+};
+
+// Вектор с копированием при записи: копии и снимки делят один буфер со счётчиком ссылок,
+// а данные копируются только при первом изменении разделённого буфера. Чтение никогда не копирует.
+// Сам объект, как и std::shared_ptr, нельзя одновременно менять из нескольких потоков,
+// но его копии и снимки в разных потоках независимы.
+template<typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class SharedVector {
+public:
+    using value_type = T;
+    using iterator = const T*;
+    using const_iterator = const T*;
+    using VectorType = Vector<T, Allocator, GrowthPolicy>;
+
+    SharedVector() = default;
+
+    explicit SharedVector(VectorType items);
+
+    SharedVector(std::initializer_list<T> items)
+            : SharedVector(VectorType(items)) {}
+
+    SharedVector(const SharedVector &other) noexcept
+            : block_(shared_vector_detail::Acquire(other.block_)) {
+    }
+
+    SharedVector(SharedVector &&other) noexcept
+            : block_(std::exchange(other.block_, nullptr)) {
+    }
+
+    SharedVector &operator=(SharedVector other) noexcept {
+        Swap(other);
+        return *this;
+    }
+
+    ~SharedVector() {shared_vector_detail::Release(block_);}
+
+    // Итерация только на чтение, чтобы обход не разделял буфер
+    const_iterator begin() const noexcept {return Data();}
+    const_iterator end() const noexcept {return Data() + Size();}
+    const_iterator cbegin() const noexcept {return begin();}
+    const_iterator cend() const noexcept {return end();}
+
+    const T *Data() const noexcept {return block_ != nullptr ? block_->items.Data() : nullptr;}
+
+    size_t Size() const noexcept {return block_ != nullptr ? block_->items.Size() : 0;}
+
+    size_t Capacity() const noexcept {return block_ != nullptr ? block_->items.Capacity() : 0;}
+
+    const T &operator[](size_t index) const noexcept {
+        assert(index < Size());
+        return Data()[index];
+    }
+
+    // Число владельцев буфера, включая снимки
+    size_t UseCount() const noexcept {
+        return block_ != nullptr ? block_->references.load(std::memory_order_relaxed) : 0;
+    }
+
+    VectorSnapshot<T, Allocator, GrowthPolicy> Snapshot() const noexcept {
+        return VectorSnapshot<T, Allocator, GrowthPolicy>(block_);
+    }
+
+    // Доступ к собственному буферу для любых изменений. Если буфер разделён, сначала копирует его
+    // с прежней вместимостью. Ссылка действительна до следующего копирования или снимка.
+    // Ссылки на элементы, взятые до вызова, после копирования указывают в чужой блок: для добавления
+    // элемента самого вектора нужен PushBack, а не Mutate().PushBack
+    VectorType &Mutate();
+
+    template <typename Type>
+    void PushBack(Type&& value) {EmplaceBack(std::forward<Type>(value));}
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+
+    void PopBack() {Mutate().PopBack();}
+
+    void Erase(size_t index) {
+        VectorType &items = Mutate();
+        items.Erase(items.begin() + index);
+    }
+
+    void Resize(size_t new_size) {Mutate().Resize(new_size);}
+
+    void Reserve(size_t new_capacity);
+
+    // Разделённый буфер просто отпускается, не копируясь
+    void Clear() noexcept;
+
+    void Swap(SharedVector &other) noexcept {std::swap(block_, other.block_);}
+
+private:
+    using Block = shared_vector_detail::Block<VectorType>;
+
+    // Делает буфер собственным и вмещающим не меньше min_capacity элементов
+    VectorType &Detach(size_t min_capacity) {
+        Block *previous = nullptr;
+        VectorType &items = Detach(min_capacity, previous);
+        shared_vector_detail::Release(previous);
+        return items;
+    }
+
+    // Как Detach, но разделённый блок, с которого снята копия, не отпускается, а возвращается в previous:
+    // пока вызывающий его не отпустит, аргументы со ссылками на старые элементы остаются действительными
+    VectorType &Detach(size_t min_capacity, Block *&previous);
+
+    bool IsShared() const noexcept {
+        return block_ != nullptr && block_->references.load(std::memory_order_acquire) != 1;
+    }
+
+    Block *block_ = nullptr;
+};
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+SharedVector<T, Allocator, GrowthPolicy>::SharedVector(VectorType items)
+        : block_(new Block(std::move(items))) {
+}
+
+// acquire видит освобождения ссылок другими владельцами: если остались только мы, их чтения завершены
+template<typename T, typename Allocator, typename GrowthPolicy>
+typename SharedVector<T, Allocator, GrowthPolicy>::VectorType &SharedVector<T, Allocator, GrowthPolicy>::Detach(
+        size_t min_capacity, Block *&previous) {
+
+    if (block_ == nullptr) {
+        block_ = new Block(VectorType());
+
+    } else if (IsShared()) {
+        const VectorType &shared = block_->items;
+
+        VectorType copy(shared.GetAllocator());
+        copy.Reserve(std::max(min_capacity, shared.Capacity()));
+        copy.Append(shared.begin(), shared.end());
+
+        previous = std::exchange(block_, new Block(std::move(copy)));
+    }
+
+    block_->items.Reserve(min_capacity);
+    return block_->items;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+typename SharedVector<T, Allocator, GrowthPolicy>::VectorType &SharedVector<T, Allocator, GrowthPolicy>::Mutate() {
+    return Detach(0);
+}
+
+// Место под новый элемент добавляется при копировании, чтобы не перевыделять буфер второй раз.
+// Старый блок отпускается только после построения элемента: args могут ссылаться на его элементы,
+// а другой владелец может освободить блок сразу после нашего Release
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename... Args>
+T &SharedVector<T, Allocator, GrowthPolicy>::EmplaceBack(Args&&... args) {
+
+    if (!IsShared()) {
+        return Mutate().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    Block *previous = nullptr;
+    VectorType &items = Detach(Size() + 1, previous);
+
+    try {
+        T &item = items.EmplaceBack(std::forward<Args>(args)...);
+        shared_vector_detail::Release(previous);
+        return item;
+    } catch (...) {
+        shared_vector_detail::Release(previous);
+        throw;
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+void SharedVector<T, Allocator, GrowthPolicy>::Reserve(size_t new_capacity) {
+    Detach(new_capacity);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+void SharedVector<T, Allocator, GrowthPolicy>::Clear() noexcept {
+
+    if (block_ != nullptr && !IsShared()) {
+        block_->items.Clear();
+    } else {
+        shared_vector_detail::Release(std::exchange(block_, nullptr));
+    }
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "vector.h"
+
+template<typename T, size_t N>
+struct InlineBuffer {
+    alignas(T) unsigned char bytes[sizeof(T) * N];
+    bool in_use = false;
+};
+
+// Отдаёт встроенный буфер на N элементов, пока он свободен, остальные запросы уходят в кучу.
+// Аллокатор привязан к конкретному буферу и никогда не передаётся другому контейнеру.
+template<typename T, size_t N>
+class InlineAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    explicit InlineAllocator(InlineBuffer<T, N> *buffer) noexcept
+            : buffer_(buffer) {
+    }
+
+    T *allocate(size_t n);
+
+    void deallocate(T *buf, size_t n) noexcept;
+
+    bool operator==(const InlineAllocator &other) const noexcept {return buffer_ == other.buffer_;}
+
+    bool operator!=(const InlineAllocator &other) const noexcept {return buffer_ != other.buffer_;}
+
+private:
+    InlineBuffer<T, N> *buffer_;
+};
+
+// Вектор, хранящий до N элементов внутри себя и обращающийся к куче только при переполнении.
+// Вся работа с элементами делегируется Vector, поэтому гарантии исключений у них общие.
+template<typename T, size_t N>
+class SmallVector : private InlineBuffer<T, N>, private Vector<T, InlineAllocator<T, N>> {
+    static_assert(N > 0);
+
+    using Base = Vector<T, InlineAllocator<T, N>>;
+
+public:
+    using typename Base::value_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+
+    SmallVector();
+
+    explicit SmallVector(size_t size);
+
+    SmallVector(std::initializer_list<T> items);
+
+    SmallVector(const SmallVector &other);
+
+    SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    SmallVector &operator=(const SmallVector &other);
+
+    SmallVector &operator=(SmallVector &&other) noexcept(std::is_nothrow_move_assignable_v<T>
+                                                         && std::is_nothrow_move_constructible_v<T>);
+
+    using Base::begin;
+    using Base::end;
+    using Base::cbegin;
+    using Base::cend;
+
+    using Base::Reserve;
+    using Base::Resize;
+    using Base::ResizeForOverwrite;
+    using Base::ResizeAndOverwrite;
+    using Base::PushBack;
+    using Base::EmplaceBack;
+    using Base::PopBack;
+    using Base::Emplace;
+    using Base::Insert;
+    using Base::Erase;
+    using Base::EraseIf;
+    using Base::UnorderedErase;
+    using Base::Append;
+    using Base::Assign;
+    using Base::Clear;
+
+    using Base::Size;
+    using Base::Capacity;
+    using Base::Data;
+    using Base::operator[];
+
+    // Возвращает элементы во встроенный буфер, если они в нём помещаются
+    void ShrinkToFit();
+
+    // Буферы в куче обмениваются за O(1), встроенные — поэлементно
+    void Swap(SmallVector &other);
+
+    bool IsInline() const noexcept;
+
+private:
+    // Пустой вектор с аллокатором этого вектора, в который можно переложить чужой буфер из кучи
+    Base EmptyStorage() noexcept {return Base(InlineAllocator<T, N>(this));}
+
+    // Забирает буфер storage, уничтожая свои элементы и освобождая свой буфер своим аллокатором.
+    // Буфер storage должен быть в куче: встроенный буфер другого вектора передать нельзя
+    void AdoptStorage(Base &storage) noexcept;
+};
+
+template<typename T, size_t N>
+T *InlineAllocator<T, N>::allocate(size_t n) {
+
+    if (n <= N && !buffer_->in_use) {
+        buffer_->in_use = true;
+        return reinterpret_cast<T *>(buffer_->bytes);
+    }
+
+    return std::allocator<T>().allocate(n);
+}
+
+template<typename T, size_t N>
+void InlineAllocator<T, N>::deallocate(T *buf, size_t n) noexcept {
+
+    if (buf == reinterpret_cast<T *>(buffer_->bytes)) {
+        buffer_->in_use = false;
+    } else {
+        std::allocator<T>().deallocate(buf, n);
+    }
+}
+
+template<typename T, size_t N>
+SmallVector<T, N>::SmallVector()
+        : Base(InlineAllocator<T, N>(this)) {
+    Base::Reserve(N);
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::AdoptStorage(Base &storage) noexcept {
+    Base old = EmptyStorage();
+    old.Swap(*this);
+    Base::Swap(storage);
+}
+
+template<typename T, size_t N>
+SmallVector<T, N>::SmallVector(size_t size)
+        : SmallVector() {
+    Base::Resize(size);
+}
+
+template<typename T, size_t N>
+SmallVector<T, N>::SmallVector(std::initializer_list<T> items)
+        : SmallVector() {
+    Base::Append(items.begin(), items.end());
+}
+
+template<typename T, size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector &other)
+        : SmallVector() {
+    Base::Append(other.begin(), other.end());
+}
+
+// Буфер из кучи забирается целиком, а other возвращается во встроенный буфер. Встроенный буфер
+// нельзя передать другому вектору, поэтому из него элементы переносятся по одному без выделений памяти
+template<typename T, size_t N>
+SmallVector<T, N>::SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : Base(InlineAllocator<T, N>(this)) {
+
+    if (!other.IsInline()) {
+        Base::Swap(other);
+        other.Base::Reserve(N);
+        return;
+    }
+
+    Base::Reserve(N);
+    Base::Append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+}
+
+template<typename T, size_t N>
+SmallVector<T, N> &SmallVector<T, N>::operator=(const SmallVector &other) {
+    Base::operator=(other);
+    return *this;
+}
+
+template<typename T, size_t N>
+SmallVector<T, N> &SmallVector<T, N>::operator=(SmallVector &&other) noexcept(
+        std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+
+    if (this == &other) {
+        return *this;
+    }
+
+    if (!other.IsInline()) {
+        Base storage = other.EmptyStorage();
+        storage.Swap(other);
+        other.Base::Reserve(N);
+        AdoptStorage(storage);
+    } else {
+        Base::Assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    }
+
+    return *this;
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::ShrinkToFit() {
+    const size_t new_capacity = std::max(Size(), N);
+
+    if (!IsInline() && Capacity() > new_capacity) {
+        Base::ReallocateTo(new_capacity);
+    }
+}
+
+// Если бросило перемещение элементов из встроенного буфера в другой, буфер из кучи возвращается на место
+template<typename T, size_t N>
+void SmallVector<T, N>::Swap(SmallVector &other) {
+
+    if (!IsInline() && !other.IsInline()) {
+        Base::Swap(other);
+        return;
+    }
+
+    if (IsInline() && other.IsInline()) {
+        SmallVector &longer = Size() >= other.Size() ? *this : other;
+        SmallVector &shorter = Size() >= other.Size() ? other : *this;
+        const size_t common = shorter.Size();
+
+        std::swap_ranges(longer.begin(), longer.begin() + common, shorter.begin());
+        shorter.Base::Append(std::make_move_iterator(longer.begin() + common),
+                             std::make_move_iterator(longer.end()));
+        longer.Base::Erase(longer.begin() + common, longer.end());
+        return;
+    }
+
+    SmallVector &heap = IsInline() ? other : *this;
+    SmallVector &inline_vector = IsInline() ? *this : other;
+
+    Base storage = heap.EmptyStorage();
+    storage.Swap(heap);
+    heap.Base::Reserve(N);
+
+    try {
+        heap.Base::Append(std::make_move_iterator(inline_vector.begin()),
+                          std::make_move_iterator(inline_vector.end()));
+    } catch (...) {
+        heap.AdoptStorage(storage);
+        throw;
+    }
+
+    inline_vector.AdoptStorage(storage);
+}
+
+template<typename T, size_t N>
+bool SmallVector<T, N>::IsInline() const noexcept {
+    return begin() == reinterpret_cast<const T *>(this->bytes);
+}
@@ -0,0 +1,413 @@
+#pragma once
+
+#include "vector.h"
+
+#include <tuple>
+
+// Непрерывный участок одной колонки SoAVector
+template<typename T>
+class ColumnSpan {
+public:
+    ColumnSpan(T *data, size_t size) noexcept
+            : data_(data), size_(size) {
+    }
+
+    T *begin() const noexcept {return data_;}
+    T *end() const noexcept {return data_ + size_;}
+
+    T *Data() const noexcept {return data_;}
+
+    size_t Size() const noexcept {return size_;}
+
+    T &operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+private:
+    T *data_;
+    size_t size_;
+};
+
+// Вектор записей, хранящий каждое поле в отдельной непрерывной колонке. Все колонки лежат в одном выделении
+// памяти, поэтому Reserve и рост делают одну аллокацию. Строка доступна как кортеж ссылок std::tuple<Ts &...>,
+// который поддерживает std::get и структурные привязки.
+// Гарантии исключений те же, что у Vector: рост и EmplaceBack не меняют вектор, если бросили исключение.
+template<typename... Ts>
+class SoAVector {
+    static_assert(sizeof...(Ts) > 0);
+
+    static constexpr size_t ALIGNMENT = std::max({alignof(Ts)...});
+
+    struct alignas(ALIGNMENT) Unit {
+        unsigned char bytes[ALIGNMENT];
+    };
+
+    using Columns = std::tuple<Ts *...>;
+    using Indices = std::index_sequence_for<Ts...>;
+
+public:
+    template<size_t I>
+    using ColumnType = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    using reference = std::tuple<Ts &...>;
+    using const_reference = std::tuple<const Ts &...>;
+
+    // Итератор по строкам: разыменование возвращает кортеж ссылок по значению
+    template<typename Container, typename Reference>
+    class RowIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::tuple<Ts...>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Reference;
+
+        RowIterator() = default;
+
+        RowIterator(Container *container, size_t index) noexcept
+                : container_(container), index_(index) {
+        }
+
+        // Неконстантный итератор приводится к константному
+        template<typename Other, typename OtherReference,
+                 typename = std::enable_if_t<std::is_same_v<const Other, Container> && !std::is_const_v<Other>>>
+        RowIterator(const RowIterator<Other, OtherReference> &other) noexcept
+                : container_(other.Owner()), index_(other.Index()) {
+        }
+
+        reference operator*() const noexcept {return (*container_)[index_];}
+        reference operator[](difference_type n) const noexcept {return (*container_)[index_ + n];}
+
+        RowIterator &operator++() noexcept {++index_; return *this;}
+        RowIterator &operator--() noexcept {--index_; return *this;}
+        RowIterator operator++(int) noexcept {RowIterator old = *this; ++index_; return old;}
+        RowIterator operator--(int) noexcept {RowIterator old = *this; --index_; return old;}
+
+        RowIterator &operator+=(difference_type n) noexcept {index_ += n; return *this;}
+        RowIterator &operator-=(difference_type n) noexcept {index_ -= n; return *this;}
+        RowIterator operator+(difference_type n) const noexcept {return RowIterator(container_, index_ + n);}
+        RowIterator operator-(difference_type n) const noexcept {return RowIterator(container_, index_ - n);}
+        friend RowIterator operator+(difference_type n, const RowIterator &it) noexcept {return it + n;}
+
+        difference_type operator-(const RowIterator &other) const noexcept {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+        }
+
+        bool operator==(const RowIterator &other) const noexcept {return index_ == other.index_;}
+        bool operator!=(const RowIterator &other) const noexcept {return index_ != other.index_;}
+        bool operator<(const RowIterator &other) const noexcept {return index_ < other.index_;}
+        bool operator>(const RowIterator &other) const noexcept {return index_ > other.index_;}
+        bool operator<=(const RowIterator &other) const noexcept {return index_ <= other.index_;}
+        bool operator>=(const RowIterator &other) const noexcept {return index_ >= other.index_;}
+
+        Container *Owner() const noexcept {return container_;}
+        size_t Index() const noexcept {return index_;}
+
+    private:
+        Container *container_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = RowIterator<SoAVector, reference>;
+    using const_iterator = RowIterator<const SoAVector, const_reference>;
+
+    SoAVector() = default;
+
+    SoAVector(const SoAVector &other);
+
+    SoAVector(SoAVector &&other) noexcept;
+
+    SoAVector &operator=(const SoAVector &other);
+
+    SoAVector &operator=(SoAVector &&other) noexcept;
+
+    ~SoAVector();
+
+    iterator begin() noexcept {return iterator(this, 0);}
+    iterator end() noexcept {return iterator(this, size_);}
+    const_iterator cbegin() const noexcept {return const_iterator(this, 0);}
+    const_iterator cend() const noexcept {return const_iterator(this, size_);}
+    const_iterator begin() const noexcept {return cbegin();}
+    const_iterator end() const noexcept {return cend();}
+
+    void Reserve(size_t new_capacity);
+
+    // Принимает по одному аргументу на каждое поле
+    template<typename... Args>
+    reference EmplaceBack(Args &&... args);
+
+    void PopBack() noexcept;
+
+    iterator Erase(const_iterator pos);
+
+    void Clear() noexcept;
+
+    size_t Size() const noexcept {return size_;}
+
+    size_t Capacity() const noexcept {return capacity_;}
+
+    template<size_t I>
+    ColumnSpan<ColumnType<I>> Column() noexcept {return {std::get<I>(columns_), size_};}
+
+    template<size_t I>
+    ColumnSpan<const ColumnType<I>> Column() const noexcept {return {std::get<I>(columns_), size_};}
+
+    reference operator[](size_t index) noexcept;
+
+    const_reference operator[](size_t index) const noexcept;
+
+    void Swap(SoAVector &other) noexcept;
+
+private:
+    // Колонки, которые при переносе нельзя переместить без риска исключения, копируются
+    template<typename T>
+    static constexpr bool IS_NOTHROW_RELOCATABLE = IsTriviallyRelocatableV<T>
+                                                   || std::is_nothrow_move_constructible_v<T>
+                                                   || !std::is_copy_constructible_v<T>;
+
+    static Columns Allocate(RawMemory<Unit> &memory, size_t capacity) {
+        return Allocate(memory, capacity, Indices{});
+    }
+
+    template<size_t... Is>
+    static Columns Allocate(RawMemory<Unit> &memory, size_t capacity, std::index_sequence<Is...>);
+
+    template<size_t... Is, typename... Args>
+    static void ConstructRow(const Columns &columns, size_t position, std::index_sequence<Is...>, Args &&... args);
+
+    template<size_t... Is>
+    static void DestroyRow(const Columns &columns, size_t position, std::index_sequence<Is...>) noexcept;
+
+    template<size_t... Is>
+    static void DestroyColumns(const Columns &columns, size_t count, std::index_sequence<Is...>) noexcept;
+
+    template<size_t... Is>
+    static void RelocateColumns(const Columns &from, const Columns &to, size_t count, std::index_sequence<Is...>);
+
+    template<size_t... Is>
+    static void CopyColumns(const Columns &from, const Columns &to, size_t count, std::index_sequence<Is...>);
+
+    void Adopt(RawMemory<Unit> &memory, const Columns &columns, size_t capacity) noexcept;
+
+    RawMemory<Unit> memory_;
+    Columns columns_{};
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+// Колонки размещаются подряд, каждая с выравниванием своего типа
+template<typename... Ts>
+template<size_t... Is>
+typename SoAVector<Ts...>::Columns SoAVector<Ts...>::Allocate(RawMemory<Unit> &memory, size_t capacity,
+                                                              std::index_sequence<Is...>) {
+
+    if (capacity > (static_cast<size_t>(-1) - sizeof...(Ts) * ALIGNMENT) / (sizeof(Ts) + ...)) {
+        throw std::bad_array_new_length();
+    }
+
+    size_t offsets[sizeof...(Ts)];
+    size_t offset = 0;
+    size_t column = 0;
+    ((offset = (offset + alignof(Ts) - 1) / alignof(Ts) * alignof(Ts),
+      offsets[column++] = offset,
+      offset += capacity * sizeof(Ts)), ...);
+
+    RawMemory<Unit> new_memory((offset + ALIGNMENT - 1) / ALIGNMENT);
+    auto *bytes = reinterpret_cast<unsigned char *>(new_memory.GetAddress());
+    memory.Swap(new_memory);
+
+    return Columns{reinterpret_cast<Ts *>(bytes + offsets[Is])...};
+}
+
+template<typename... Ts>
+template<size_t... Is, typename... Args>
+void SoAVector<Ts...>::ConstructRow(const Columns &columns, size_t position, std::index_sequence<Is...>,
+                                    Args &&... args) {
+    size_t constructed = 0;
+
+    try {
+        ((new (std::get<Is>(columns) + position) Ts(std::forward<Args>(args)), ++constructed), ...);
+    } catch (...) {
+        ((Is < constructed ? std::destroy_at(std::get<Is>(columns) + position) : void()), ...);
+        throw;
+    }
+}
+
+template<typename... Ts>
+template<size_t... Is>
+void SoAVector<Ts...>::DestroyRow(const Columns &columns, size_t position, std::index_sequence<Is...>) noexcept {
+    (std::destroy_at(std::get<Is>(columns) + position), ...);
+}
+
+template<typename... Ts>
+template<size_t... Is>
+void SoAVector<Ts...>::DestroyColumns(const Columns &columns, size_t count, std::index_sequence<Is...>) noexcept {
+    (std::destroy_n(std::get<Is>(columns), count), ...);
+}
+
+// Сначала копируются колонки, перенос которых может бросить исключение: при ошибке старые колонки
+// ещё не тронуты и удаляются только копии. Затем без риска переносятся остальные.
+template<typename... Ts>
+template<size_t... Is>
+void SoAVector<Ts...>::RelocateColumns(const Columns &from, const Columns &to, size_t count,
+                                       std::index_sequence<Is...>) {
+    size_t copied = 0;
+
+    try {
+        ((!IS_NOTHROW_RELOCATABLE<Ts>
+          ? (std::uninitialized_copy_n(std::get<Is>(from), count, std::get<Is>(to)), void(++copied))
+          : void()), ...);
+    } catch (...) {
+        size_t column = 0;
+        ((!IS_NOTHROW_RELOCATABLE<Ts> && column++ < copied ? void(std::destroy_n(std::get<Is>(to), count)) : void()), ...);
+        throw;
+    }
+
+    ((IS_NOTHROW_RELOCATABLE<Ts>
+      ? UninitializedRelocateN(std::get<Is>(from), count, std::get<Is>(to))
+      : void(std::destroy_n(std::get<Is>(from), count))), ...);
+}
+
+template<typename... Ts>
+template<size_t... Is>
+void SoAVector<Ts...>::CopyColumns(const Columns &from, const Columns &to, size_t count, std::index_sequence<Is...>) {
+    size_t copied = 0;
+
+    try {
+        ((std::uninitialized_copy_n(std::get<Is>(from), count, std::get<Is>(to)), ++copied), ...);
+    } catch (...) {
+        ((Is < copied ? void(std::destroy_n(std::get<Is>(to), count)) : void()), ...);
+        throw;
+    }
+}
+
+template<typename... Ts>
+void SoAVector<Ts...>::Adopt(RawMemory<Unit> &memory, const Columns &columns, size_t capacity) noexcept {
+    memory_.Swap(memory);
+    columns_ = columns;
+    capacity_ = capacity;
+}
+
+template<typename... Ts>
+SoAVector<Ts...>::SoAVector(const SoAVector &other) {
+    RawMemory<Unit> memory;
+    const Columns columns = Allocate(memory, other.size_);
+    CopyColumns(other.columns_, columns, other.size_, Indices{});
+
+    Adopt(memory, columns, other.size_);
+    size_ = other.size_;
+}
+
+template<typename... Ts>
+SoAVector<Ts...>::SoAVector(SoAVector &&other) noexcept
+        : memory_(std::move(other.memory_)),
+          columns_(std::exchange(other.columns_, Columns{})),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)) {
+}
+
+template<typename... Ts>
+SoAVector<Ts...> &SoAVector<Ts...>::operator=(const SoAVector &other) {
+
+    if (this != &other) {
+        SoAVector other_copy(other);
+        Swap(other_copy);
+    }
+
+    return *this;
+}
+
+template<typename... Ts>
+SoAVector<Ts...> &SoAVector<Ts...>::operator=(SoAVector &&other) noexcept {
+    Swap(other);
+    return *this;
+}
+
+template<typename... Ts>
+SoAVector<Ts...>::~SoAVector() {
+    DestroyColumns(columns_, size_, Indices{});
+}
+
+template<typename... Ts>
+void SoAVector<Ts...>::Swap(SoAVector &other) noexcept {
+    memory_.Swap(other.memory_);
+    std::swap(columns_, other.columns_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+}
+
+template<typename... Ts>
+typename SoAVector<Ts...>::reference SoAVector<Ts...>::operator[](size_t index) noexcept {
+    assert(index < size_);
+    return std::apply([index](Ts *... columns) {return reference(columns[index]...);}, columns_);
+}
+
+template<typename... Ts>
+typename SoAVector<Ts...>::const_reference SoAVector<Ts...>::operator[](size_t index) const noexcept {
+    assert(index < size_);
+    return std::apply([index](Ts *... columns) {return const_reference(columns[index]...);}, columns_);
+}
+
+template<typename... Ts>
+void SoAVector<Ts...>::Reserve(size_t new_capacity) {
+
+    if (new_capacity > capacity_) {
+        RawMemory<Unit> memory;
+        const Columns columns = Allocate(memory, new_capacity);
+        RelocateColumns(columns_, columns, size_, Indices{});
+        Adopt(memory, columns, new_capacity);
+    }
+}
+
+// Как и в Vector, новая строка строится до переноса: аргументы могут ссылаться на элементы вектора
+template<typename... Ts>
+template<typename... Args>
+typename SoAVector<Ts...>::reference SoAVector<Ts...>::EmplaceBack(Args &&... args) {
+    static_assert(sizeof...(Args) == sizeof...(Ts), "EmplaceBack takes one argument per field");
+
+    if (size_ == capacity_) {
+        const size_t new_capacity = DoublingGrowth::NextCapacity(capacity_, size_ + 1, (sizeof(Ts) + ...));
+        RawMemory<Unit> memory;
+        const Columns columns = Allocate(memory, new_capacity);
+        ConstructRow(columns, size_, Indices{}, std::forward<Args>(args)...);
+
+        try {
+            RelocateColumns(columns_, columns, size_, Indices{});
+        } catch (...) {
+            DestroyRow(columns, size_, Indices{});
+            throw;
+        }
+
+        Adopt(memory, columns, new_capacity);
+    } else {
+        ConstructRow(columns_, size_, Indices{}, std::forward<Args>(args)...);
+    }
+
+    return (*this)[size_++];
+}
+
+template<typename... Ts>
+void SoAVector<Ts...>::PopBack() noexcept {
+    assert(size_);
+    DestroyRow(columns_, --size_, Indices{});
+}
+
+template<typename... Ts>
+typename SoAVector<Ts...>::iterator SoAVector<Ts...>::Erase(const_iterator pos) {
+    const size_t position = pos.Index();
+    assert(position < size_);
+
+    std::apply([this, position](Ts *... columns) {
+        (std::move(columns + position + 1, columns + size_, columns + position), ...);
+    }, columns_);
+    PopBack();
+
+    return iterator(this, position);
+}
+
+template<typename... Ts>
+void SoAVector<Ts...>::Clear() noexcept {
+    DestroyColumns(columns_, size_, Indices{});
+    size_ = 0;
+}
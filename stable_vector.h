@@ -0,0 +1,214 @@
+#pragma once
+
+#include "vector.h"
+#include "geometric_segments.h"
+#include "index_iterator.h"
+
+// Вектор, который никогда не перемещает элементы: память растёт блоками FirstBlockSize, 2 * FirstBlockSize, 4 * ...
+// Рост стоит одного выделения нового блока, а ссылки и указатели на элементы остаются корректными
+// до удаления самого элемента. Доступ по индексу — O(1): номер блока вычисляется по старшему биту индекса.
+template<typename T, size_t FirstBlockSize = 16>
+class StableVector {
+    using Blocks = GeometricSegments<FirstBlockSize>;
+
+public:
+    using value_type = T;
+    using iterator = IndexIterator<StableVector, T>;
+    using const_iterator = IndexIterator<const StableVector, const T>;
+
+    StableVector() = default;
+
+    explicit StableVector(size_t size);
+
+    StableVector(std::initializer_list<T> items);
+
+    StableVector(const StableVector &other);
+
+    StableVector(StableVector &&other) noexcept;
+
+    StableVector &operator=(const StableVector &other);
+
+    StableVector &operator=(StableVector &&other) noexcept;
+
+    ~StableVector();
+
+    iterator begin() noexcept {return iterator(this, 0);}
+    iterator end() noexcept {return iterator(this, size_);}
+    const_iterator cbegin() const noexcept {return const_iterator(this, 0);}
+    const_iterator cend() const noexcept {return const_iterator(this, size_);}
+    const_iterator begin() const noexcept {return cbegin();}
+    const_iterator end() const noexcept {return cend();}
+
+    // Выделяет недостающие блоки, существующие элементы не трогает
+    void Reserve(size_t new_capacity);
+
+    void Resize(size_t new_size);
+
+    // Освобождает блоки, в которых не осталось элементов
+    void ShrinkToFit() noexcept;
+
+    template<typename Type>
+    void PushBack(Type &&value);
+
+    template<typename... Args>
+    T &EmplaceBack(Args &&... args);
+
+    void PopBack() noexcept;
+
+    void Clear() noexcept;
+
+    size_t Size() const noexcept {return size_;}
+
+    size_t Capacity() const noexcept {return Blocks::Begin(blocks_.Size());}
+
+    const T &operator[](size_t index) const noexcept;
+
+    T &operator[](size_t index) noexcept;
+
+    void Swap(StableVector &other) noexcept;
+
+private:
+    Vector<RawMemory<T>> blocks_;
+    size_t size_ = 0;
+};
+
+template<typename T, size_t FirstBlockSize>
+StableVector<T, FirstBlockSize>::StableVector(size_t size)
+        : StableVector() {
+    Resize(size);
+}
+
+// Делегирующий конструктор гарантирует вызов деструктора, если копирование элемента бросит исключение
+template<typename T, size_t FirstBlockSize>
+StableVector<T, FirstBlockSize>::StableVector(std::initializer_list<T> items)
+        : StableVector() {
+    Reserve(items.size());
+
+    for (const T &item : items) {
+        EmplaceBack(item);
+    }
+}
+
+template<typename T, size_t FirstBlockSize>
+StableVector<T, FirstBlockSize>::StableVector(const StableVector &other)
+        : StableVector() {
+    Reserve(other.size_);
+
+    for (const T &item : other) {
+        EmplaceBack(item);
+    }
+}
+
+template<typename T, size_t FirstBlockSize>
+StableVector<T, FirstBlockSize>::StableVector(StableVector &&other) noexcept
+        : blocks_(std::move(other.blocks_)), size_(std::exchange(other.size_, 0)) {
+}
+
+template<typename T, size_t FirstBlockSize>
+StableVector<T, FirstBlockSize> &StableVector<T, FirstBlockSize>::operator=(const StableVector &other) {
+
+    if (this != &other) {
+        StableVector other_copy(other);
+        Swap(other_copy);
+    }
+
+    return *this;
+}
+
+template<typename T, size_t FirstBlockSize>
+StableVector<T, FirstBlockSize> &StableVector<T, FirstBlockSize>::operator=(StableVector &&other) noexcept {
+    Swap(other);
+    return *this;
+}
+
+template<typename T, size_t FirstBlockSize>
+StableVector<T, FirstBlockSize>::~StableVector() {
+    Clear();
+}
+
+template<typename T, size_t FirstBlockSize>
+void StableVector<T, FirstBlockSize>::Swap(StableVector &other) noexcept {
+    blocks_.Swap(other.blocks_);
+    std::swap(size_, other.size_);
+}
+
+template<typename T, size_t FirstBlockSize>
+T &StableVector<T, FirstBlockSize>::operator[](size_t index) noexcept {
+    assert(index < size_);
+
+    const size_t block = Blocks::SegmentOf(index);
+    return blocks_[block][index - Blocks::Begin(block)];
+}
+
+template<typename T, size_t FirstBlockSize>
+const T &StableVector<T, FirstBlockSize>::operator[](size_t index) const noexcept {
+    return const_cast<StableVector &>(*this)[index];
+}
+
+template<typename T, size_t FirstBlockSize>
+void StableVector<T, FirstBlockSize>::Reserve(size_t new_capacity) {
+
+    while (Capacity() < new_capacity) {
+        blocks_.EmplaceBack(Blocks::Size(blocks_.Size()));
+    }
+}
+
+template<typename T, size_t FirstBlockSize>
+void StableVector<T, FirstBlockSize>::Resize(size_t new_size) {
+    Reserve(new_size);
+
+    while (size_ < new_size) {
+        EmplaceBack();
+    }
+
+    while (size_ > new_size) {
+        PopBack();
+    }
+}
+
+template<typename T, size_t FirstBlockSize>
+void StableVector<T, FirstBlockSize>::ShrinkToFit() noexcept {
+
+    while (blocks_.Size() != 0 && Blocks::Begin(blocks_.Size() - 1) >= size_) {
+        blocks_.PopBack();
+    }
+}
+
+template<typename T, size_t FirstBlockSize>
+template<typename Type>
+void StableVector<T, FirstBlockSize>::PushBack(Type &&value) {
+    EmplaceBack(std::forward<Type>(value));
+}
+
+// Существующие элементы не перемещаются, поэтому аргументы могут ссылаться на элементы вектора
+template<typename T, size_t FirstBlockSize>
+template<typename... Args>
+T &StableVector<T, FirstBlockSize>::EmplaceBack(Args &&... args) {
+
+    if (size_ == Capacity()) {
+        blocks_.EmplaceBack(Blocks::Size(blocks_.Size()));
+    }
+
+    const size_t block = Blocks::SegmentOf(size_);
+    T *elem = new (blocks_[block] + (size_ - Blocks::Begin(block))) T(std::forward<Args>(args)...);
+    ++size_;
+
+    return *elem;
+}
+
+template<typename T, size_t FirstBlockSize>
+void StableVector<T, FirstBlockSize>::PopBack() noexcept {
+    assert(size_);
+    std::destroy_at(&(*this)[size_ - 1]);
+    --size_;
+}
+
+template<typename T, size_t FirstBlockSize>
+void StableVector<T, FirstBlockSize>::Clear() noexcept {
+
+    for (size_t block = 0; block != blocks_.Size() && Blocks::Begin(block) < size_; ++block) {
+        std::destroy_n(blocks_[block].GetAddress(), std::min(size_ - Blocks::Begin(block), Blocks::Size(block)));
+    }
+
+    size_ = 0;
+}
@@ -0,0 +1,386 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace static_vector_detail {
+
+    template<typename T, typename... Args>
+    constexpr void ConstructAt(T *buf, Args &&...args) {
+#ifdef __cpp_lib_constexpr_dynamic_alloc
+        std::construct_at(buf, std::forward<Args>(args)...);
+#else
+        ::new(static_cast<void *>(buf)) T(std::forward<Args>(args)...);
+#endif
+    }
+
+    template<typename T>
+    constexpr void DestroyN(T *buf, size_t n) noexcept {
+
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i != n; ++i) {
+                buf[i].~T();
+            }
+        }
+    }
+
+    // Тривиальные элементы хранятся обычным массивом, поэтому с ними вектор работает в constexpr
+    template<typename T, size_t N, bool = std::is_trivial_v<T>>
+    struct Storage {
+        constexpr Storage() noexcept {
+#ifdef __cpp_lib_is_constant_evaluated
+            // Результат константного вычисления не может содержать неинициализированных подобъектов
+            if (std::is_constant_evaluated()) {
+                for (T &item : items) {
+                    item = T();
+                }
+            }
+#endif
+        }
+
+        constexpr T *Data() noexcept {return items;}
+        constexpr const T *Data() const noexcept {return items;}
+
+        T items[N];
+    };
+
+    template<typename T, size_t N>
+    struct Storage<T, N, false> {
+        T *Data() noexcept {return std::launder(reinterpret_cast<T *>(bytes));}
+        const T *Data() const noexcept {return std::launder(reinterpret_cast<const T *>(bytes));}
+
+        alignas(T) unsigned char bytes[sizeof(T) * N];
+    };
+
+    // Для тривиально копируемых T копирование и разрушение остаются тривиальными
+    template<typename T, size_t N, bool = std::is_trivially_copyable_v<T>>
+    class Base {
+    protected:
+        Storage<T, N> storage_;
+        size_t size_ = 0;
+    };
+
+    template<typename T, size_t N>
+    class Base<T, N, false> {
+    protected:
+        Base() = default;
+
+        Base(const Base &other);
+
+        Base(Base &&other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+        Base &operator=(const Base &other);
+
+        Base &operator=(Base &&other) noexcept(std::is_nothrow_move_assignable_v<T>
+                                               && std::is_nothrow_move_constructible_v<T>);
+
+        ~Base() {DestroyN(storage_.Data(), size_);}
+
+        // Присваивает элементы из first, достраивая или разрушая хвост
+        template<typename InputIt>
+        void AssignFrom(InputIt first, size_t count);
+
+        template<typename InputIt>
+        void ConstructFrom(InputIt first, size_t count);
+
+        Storage<T, N> storage_;
+        size_t size_ = 0;
+    };
+
+} // namespace static_vector_detail
+
+// Вектор вместимостью N элементов внутри себя, без обращений к куче. Переполнение — std::length_error,
+// TryPushBack вместо этого возвращает false. Для тривиальных T все операции constexpr (C++20),
+// для тривиально копируемых T сам вектор тривиально копируем.
+template<typename T, size_t N>
+class StaticVector : private static_vector_detail::Base<T, N> {
+    static_assert(N > 0);
+
+    using Base = static_vector_detail::Base<T, N>;
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    StaticVector() = default;
+
+    constexpr explicit StaticVector(size_t size);
+
+    constexpr StaticVector(std::initializer_list<T> items);
+
+    constexpr iterator begin() noexcept {return Data();}
+    constexpr iterator end() noexcept {return Data() + this->size_;}
+    constexpr const_iterator cbegin() const noexcept {return Data();}
+    constexpr const_iterator cend() const noexcept {return Data() + this->size_;}
+    constexpr const_iterator begin() const noexcept {return cbegin();}
+    constexpr const_iterator end() const noexcept {return cend();}
+
+    constexpr T *Data() noexcept {return this->storage_.Data();}
+    constexpr const T *Data() const noexcept {return this->storage_.Data();}
+
+    constexpr size_t Size() const noexcept {return this->size_;}
+
+    static constexpr size_t Capacity() noexcept {return N;}
+
+    constexpr T &operator[](size_t index) noexcept;
+
+    constexpr const T &operator[](size_t index) const noexcept;
+
+    template <typename Type>
+    constexpr void PushBack(Type&& value) {EmplaceBack(std::forward<Type>(value));}
+
+    template <typename... Args>
+    constexpr T& EmplaceBack(Args&&... args);
+
+    // Не меняет вектор и возвращает false, если он заполнен
+    template <typename Type>
+    constexpr bool TryPushBack(Type&& value) {return TryEmplaceBack(std::forward<Type>(value)) != nullptr;}
+
+    // Возвращает nullptr, если вектор заполнен
+    template <typename... Args>
+    constexpr T* TryEmplaceBack(Args&&... args);
+
+    constexpr void PopBack() noexcept;
+
+    template <typename... Args>
+    constexpr iterator Emplace(const_iterator pos, Args&&... args);
+
+    constexpr iterator Insert(const_iterator pos, const T& item) {return Emplace(pos, item);}
+    constexpr iterator Insert(const_iterator pos, T&& item) {return Emplace(pos, std::move(item));}
+
+    constexpr iterator Erase(const_iterator pos) {
+        assert(pos >= begin() && pos < end());
+        return Erase(pos, pos + 1);
+    }
+
+    constexpr iterator Erase(const_iterator first, const_iterator last);
+
+    constexpr void Resize(size_t new_size);
+
+    constexpr void Clear() noexcept {
+        static_vector_detail::DestroyN(Data(), this->size_);
+        this->size_ = 0;
+    }
+
+    constexpr void Swap(StaticVector &other);
+
+private:
+    // Если конструктор по умолчанию бросил, вектор возвращается к прежнему размеру
+    void GrowOrRollback(size_t new_size);
+
+    static void ThrowLengthError() {throw std::length_error("StaticVector: capacity exceeded");}
+};
+
+template<typename T, size_t N>
+static_vector_detail::Base<T, N, false>::Base(const Base &other) {
+    ConstructFrom(other.storage_.Data(), other.size_);
+}
+
+template<typename T, size_t N>
+static_vector_detail::Base<T, N, false>::Base(Base &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    ConstructFrom(std::make_move_iterator(other.storage_.Data()), other.size_);
+}
+
+template<typename T, size_t N>
+static_vector_detail::Base<T, N, false> &static_vector_detail::Base<T, N, false>::operator=(const Base &other) {
+
+    if (this != &other) {
+        AssignFrom(other.storage_.Data(), other.size_);
+    }
+
+    return *this;
+}
+
+template<typename T, size_t N>
+static_vector_detail::Base<T, N, false> &static_vector_detail::Base<T, N, false>::operator=(Base &&other) noexcept(
+        std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+
+    if (this != &other) {
+        AssignFrom(std::make_move_iterator(other.storage_.Data()), other.size_);
+    }
+
+    return *this;
+}
+
+// Для конструкторов: при исключении разрушает построенное, так как деструктор не будет вызван
+template<typename T, size_t N>
+template<typename InputIt>
+void static_vector_detail::Base<T, N, false>::ConstructFrom(InputIt first, size_t count) {
+
+    try {
+        AssignFrom(first, count);
+    } catch (...) {
+        DestroyN(storage_.Data(), size_);
+        throw;
+    }
+}
+
+// Если построение хвоста бросило, в векторе остаются уже присвоенные и построенные элементы
+template<typename T, size_t N>
+template<typename InputIt>
+void static_vector_detail::Base<T, N, false>::AssignFrom(InputIt first, size_t count) {
+    T *data = storage_.Data();
+    const size_t common = std::min(size_, count);
+
+    for (size_t i = 0; i != common; ++i, ++first) {
+        data[i] = *first;
+    }
+
+    if (count < size_) {
+        DestroyN(data + count, size_ - count);
+        size_ = count;
+    }
+
+    for (; size_ < count; ++size_, ++first) {
+        ConstructAt(data + size_, *first);
+    }
+}
+
+template<typename T, size_t N>
+constexpr StaticVector<T, N>::StaticVector(size_t size) {
+    Resize(size);
+}
+
+template<typename T, size_t N>
+constexpr StaticVector<T, N>::StaticVector(std::initializer_list<T> items) {
+
+    if (items.size() > N) {
+        ThrowLengthError();
+    }
+
+    for (const T &item : items) {
+        EmplaceBack(item);
+    }
+}
+
+template<typename T, size_t N>
+constexpr T &StaticVector<T, N>::operator[](size_t index) noexcept {
+    assert(index < this->size_);
+    return Data()[index];
+}
+
+template<typename T, size_t N>
+constexpr const T &StaticVector<T, N>::operator[](size_t index) const noexcept {
+    assert(index < this->size_);
+    return Data()[index];
+}
+
+template<typename T, size_t N>
+template<typename... Args>
+constexpr T &StaticVector<T, N>::EmplaceBack(Args&&... args) {
+    T *item = TryEmplaceBack(std::forward<Args>(args)...);
+
+    if (item == nullptr) {
+        ThrowLengthError();
+    }
+
+    return *item;
+}
+
+template<typename T, size_t N>
+template<typename... Args>
+constexpr T *StaticVector<T, N>::TryEmplaceBack(Args&&... args) {
+
+    if (this->size_ == N) {
+        return nullptr;
+    }
+
+    T *item = Data() + this->size_;
+    static_vector_detail::ConstructAt(item, std::forward<Args>(args)...);
+    ++this->size_;
+    return item;
+}
+
+template<typename T, size_t N>
+constexpr void StaticVector<T, N>::PopBack() noexcept {
+    assert(this->size_);
+    static_vector_detail::DestroyN(Data() + this->size_ - 1, 1);
+    --this->size_;
+}
+
+// Элемент строится до сдвига, так как аргументы могут ссылаться на элементы вектора
+template<typename T, size_t N>
+template<typename... Args>
+constexpr typename StaticVector<T, N>::iterator StaticVector<T, N>::Emplace(const_iterator pos, Args&&... args) {
+    assert(pos >= begin() && pos <= end());
+    const size_t position = pos - begin();
+
+    if (this->size_ == N) {
+        ThrowLengthError();
+    }
+
+    if (position == this->size_) {
+        EmplaceBack(std::forward<Args>(args)...);
+        return begin() + position;
+    }
+
+    T item(std::forward<Args>(args)...);
+    static_vector_detail::ConstructAt(end(), std::move(*(end() - 1)));
+    ++this->size_;
+
+    std::move_backward(begin() + position, end() - 2, end() - 1);
+    *(begin() + position) = std::move(item);
+    return begin() + position;
+}
+
+template<typename T, size_t N>
+constexpr typename StaticVector<T, N>::iterator StaticVector<T, N>::Erase(const_iterator first, const_iterator last) {
+    assert(first >= begin() && first <= last && last <= end());
+    const size_t position = first - begin();
+    const size_t count = last - first;
+
+    std::move(begin() + position + count, end(), begin() + position);
+    static_vector_detail::DestroyN(end() - count, count);
+    this->size_ -= count;
+    return begin() + position;
+}
+
+template<typename T, size_t N>
+constexpr void StaticVector<T, N>::Resize(size_t new_size) {
+
+    if (new_size > N) {
+        ThrowLengthError();
+    }
+
+    if (new_size < this->size_) {
+        static_vector_detail::DestroyN(Data() + new_size, this->size_ - new_size);
+        this->size_ = new_size;
+    }
+
+    if constexpr (std::is_nothrow_default_constructible_v<T>) {
+        while (this->size_ < new_size) {
+            EmplaceBack();
+        }
+    } else {
+        GrowOrRollback(new_size);
+    }
+}
+
+template<typename T, size_t N>
+void StaticVector<T, N>::GrowOrRollback(size_t new_size) {
+    const size_t old_size = this->size_;
+
+    try {
+        while (this->size_ < new_size) {
+            EmplaceBack();
+        }
+    } catch (...) {
+        Resize(old_size);
+        throw;
+    }
+}
+
+template<typename T, size_t N>
+constexpr void StaticVector<T, N>::Swap(StaticVector &other) {
+    StaticVector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+}
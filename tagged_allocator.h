@@ -0,0 +1,43 @@
+#pragma once
+
+#include "vector.h"
+
+#include <memory>
+#include <type_traits>
+
+// Аллокатор Base, помеченный тегом статистики: выделения и переносы векторов с ним считаются
+// в счётчиках Tag (см. vector_instrumentation.h). Всё остальное, включая reallocate и construct,
+// наследуется от Base, так что без VECTOR_INSTRUMENTATION вектор ведёт себя как с самим Base.
+template<typename T, typename Tag, typename Base = std::allocator<T>>
+class TaggedAllocator : public Base {
+public:
+    using value_type = T;
+    using instrumentation_tag = Tag;
+
+    template<typename U>
+    struct rebind {
+        using other = TaggedAllocator<U, Tag, typename std::allocator_traits<Base>::template rebind_alloc<U>>;
+    };
+
+    TaggedAllocator() = default;
+
+    // Неявное, так как select_on_container_copy_construction базового аллокатора возвращает Base
+    TaggedAllocator(const Base &base) noexcept
+            : Base(base) {
+    }
+
+    template<typename U, typename OtherBase>
+    TaggedAllocator(const TaggedAllocator<U, Tag, OtherBase> &other) noexcept
+            : Base(static_cast<const OtherBase &>(other)) {
+    }
+};
+
+// Политика для второго параметра Vector: Vector<int, Tagged<MyTag>> или Vector<float, Tagged<MyTag, Align<64>>>
+template<typename Tag, typename Policy = std::allocator<void>>
+struct Tagged {};
+
+template<typename T, typename Tag, typename Policy>
+struct AllocatorFor<T, Tagged<Tag, Policy>> {
+    using type = TaggedAllocator<T, Tag,
+            typename std::allocator_traits<AllocatorForT<T, Policy>>::template rebind_alloc<T>>;
+};
@@ -2,19 +2,171 @@
 
 #include <cassert>
 #include <memory>
+#include <memory_resource>
 #include <algorithm>
 #include <cstdlib>
 #include <new>
 #include <utility>
 #include <iterator>
+#include <cstring>
+#include <type_traits>
+#include <initializer_list>
+#include <functional>
 
+#include "vector_instrumentation.h"
+
+// Тип можно перенести побайтовым копированием, не вызывая конструктор перемещения
+// и деструктор исходного объекта. Пользовательские типы подключаются специализацией.
+template<typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+struct IsTriviallyRelocatable<std::unique_ptr<T>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<T>::value;
+
+// Переносит n объектов из first в неинициализированную память dest, диапазоны не пересекаются.
+// Если T нельзя переместить без исключений, объекты копируются и при ошибке first не меняется.
+template<typename T>
+void UninitializedRelocateN(T *first, size_t n, T *dest) {
+
+    if constexpr (IsTriviallyRelocatableV<T>) {
+        if (n != 0) {
+            std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), n * sizeof(T));
+        }
+    } else {
+
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(first, n, dest);
+        } else {
+            std::uninitialized_copy_n(first, n, dest);
+        }
+
+        std::destroy_n(first, n);
+    }
+}
+
+// Сдвигает n объектов внутри одного буфера, диапазоны могут пересекаться
+template<typename T>
+void RelocateWithin(T *first, size_t n, T *dest) noexcept {
+    static_assert(IsTriviallyRelocatableV<T>);
+
+    if (n != 0) {
+        std::memmove(static_cast<void *>(dest), static_cast<const void *>(first), n * sizeof(T));
+    }
+}
+
+template<typename Allocator, typename T, typename = void>
+struct HasCustomConstruct : std::false_type {};
+
+template<typename Allocator, typename T>
+struct HasCustomConstruct<Allocator, T, std::void_t<decltype(
+        std::declval<Allocator &>().construct(std::declval<T *>(), std::declval<T &&>()))>> : std::true_type {};
+
+// Аллокатор конструирует объекты обычным placement new, поэтому вместо поэлементных
+// вызовов allocator_traits можно использовать алгоритмы из <memory>
+template<typename Allocator, typename T>
+inline constexpr bool UsesPlacementConstructV = std::disjunction_v<std::is_same<Allocator, std::allocator<T>>,
+        std::negation<HasCustomConstruct<Allocator, T>>>;
+
+template<typename Allocator, typename T, typename = void>
+struct HasReallocate : std::false_type {};
+
+template<typename Allocator, typename T>
+struct HasReallocate<Allocator, T, std::void_t<decltype(
+        std::declval<Allocator &>().reallocate(std::declval<T *>(), size_t(), size_t()))>> : std::true_type {};
+
+// Буфер можно расширить средствами аллокатора (realloc, mremap), не перенося элементы вручную
+template<typename Allocator, typename T>
+inline constexpr bool ReallocatesInPlaceV = HasReallocate<Allocator, T>::value && IsTriviallyRelocatableV<T>;
+
+// Тег конструктора, оставляющего тривиальные элементы неинициализированными
+struct DefaultInitT {
+    explicit DefaultInitT() = default;
+};
+
+inline constexpr DefaultInitT DefaultInit{};
+
+template<typename It>
+using RequireInputIterator = std::enable_if_t<std::is_convertible_v<
+        typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>>;
+
+template<typename It>
+inline constexpr bool IsForwardIteratorV = std::is_convertible_v<
+        typename std::iterator_traits<It>::iterator_category, std::forward_iterator_tag>;
+
+// Прямой итератор по count копиям одного значения, позволяет заполнять вектор теми же
+// функциями, что копируют диапазоны
 template<typename T>
+class RepeatIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    RepeatIterator(const T &value, size_t index) noexcept
+            : value_(&value), index_(index) {
+    }
+
+    reference operator*() const noexcept {return *value_;}
+    pointer operator->() const noexcept {return value_;}
+
+    RepeatIterator &operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    RepeatIterator operator++(int) noexcept {
+        RepeatIterator old = *this;
+        ++index_;
+        return old;
+    }
+
+    bool operator==(const RepeatIterator &other) const noexcept {return index_ == other.index_;}
+    bool operator!=(const RepeatIterator &other) const noexcept {return index_ != other.index_;}
+
+private:
+    const T *value_;
+    size_t index_;
+};
+
+// Второй параметр RawMemory и Vector может быть политикой размещения (например, Align<64>),
+// которая по специализации AllocatorFor превращается в аллокатор для T
+template<typename T, typename Allocator>
+struct AllocatorFor {
+    using type = Allocator;
+};
+
+template<typename T, typename Allocator>
+using AllocatorForT = typename AllocatorFor<T, Allocator>::type;
+
+template<typename Allocator, typename = void>
+struct AllocatorAlignment : std::integral_constant<size_t, 0> {};
+
+template<typename Allocator>
+struct AllocatorAlignment<Allocator, std::void_t<decltype(Allocator::alignment)>>
+        : std::integral_constant<size_t, Allocator::alignment> {};
+
+// Выравнивание, которое гарантируется для начала буфера
+template<typename Allocator, typename T>
+inline constexpr size_t AllocationAlignmentV = std::max(alignof(T), AllocatorAlignment<Allocator>::value);
+
+template<typename T, typename Allocator = std::allocator<T>>
 class RawMemory {
 public:
+    using allocator_type = AllocatorForT<T, Allocator>;
+
     RawMemory() = default;
 
-    explicit RawMemory(size_t capacity)
-            : buffer_(Allocate(capacity)), capacity_(capacity) {
+    explicit RawMemory(const allocator_type &alloc) noexcept
+            : alloc_(alloc) {
+    }
+
+    explicit RawMemory(size_t capacity, const allocator_type &alloc = allocator_type())
+            : alloc_(alloc), buffer_(Allocate(capacity)), capacity_(capacity) {
     }
 
     ~RawMemory();
@@ -23,16 +175,22 @@ public:
 
     RawMemory &operator=(const RawMemory &rhs) = delete;
 
-    RawMemory(RawMemory &&other) noexcept: buffer_(std::exchange(other.buffer_, nullptr)),
+    RawMemory(RawMemory &&other) noexcept: alloc_(std::move(other.alloc_)),
+                                           buffer_(std::exchange(other.buffer_, nullptr)),
                                            capacity_(std::exchange(other.capacity_, 0)) {}
 
+    // Если аллокатор не распространяется при перемещении, аллокаторы обязаны быть равны
     RawMemory &operator=(RawMemory &&rhs) noexcept {
 
         if (this != &rhs) {
-            buffer_ = std::move(rhs.buffer_);
-            capacity_ = std::move(rhs.capacity_);
-            rhs.buffer_ = nullptr;
-            rhs.capacity_ = 0;
+            Deallocate(buffer_, capacity_);
+
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = std::move(rhs.alloc_);
+            }
+
+            buffer_ = std::exchange(rhs.buffer_, nullptr);
+            capacity_ = std::exchange(rhs.capacity_, 0);
         }
 
         return *this;
@@ -55,31 +213,108 @@ public:
 
     size_t Capacity() const;
 
+    void Reallocate(size_t new_capacity);
+
+    allocator_type &GetAllocator() noexcept {return alloc_;}
+    const allocator_type &GetAllocator() const noexcept {return alloc_;}
+
+    static constexpr size_t Alignment() noexcept {return AllocationAlignmentV<allocator_type, T>;}
+
 private:
-    static T *Allocate(size_t n);
+    using AllocTraits = std::allocator_traits<allocator_type>;
+    using Probe = VectorProbe<allocator_type>;
 
-    static void Deallocate(T *buf) noexcept;
+    T *Allocate(size_t n);
 
+    void Deallocate(T *buf, size_t n) noexcept;
+
+    [[no_unique_address]] allocator_type alloc_;
     T *buffer_ = nullptr;
     size_t capacity_ = 0;
 };
 
 
-template<typename T>
+// Политики роста: NextCapacity возвращает новую вместимость не меньше required
+template<size_t Numerator, size_t Denominator>
+struct GrowthFactor {
+    static_assert(Numerator > Denominator);
+
+    static size_t NextCapacity(size_t capacity, size_t required, size_t) noexcept {
+        const size_t grown = capacity > static_cast<size_t>(-1) / Numerator
+                             ? static_cast<size_t>(-1) : capacity * Numerator / Denominator;
+        return std::max({grown, required, size_t(1)});
+    }
+};
+
+using DoublingGrowth = GrowthFactor<2, 1>;
+using OneAndHalfGrowth = GrowthFactor<3, 2>;
+
+// Буферы от одной страницы округляются до целого числа страниц
+template<typename Base = DoublingGrowth, size_t PageSize = 4096>
+struct PageRoundedGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t bytes = Base::NextCapacity(capacity, required, element_size) * element_size;
+
+        if (bytes < PageSize) {
+            return bytes / element_size;
+        }
+
+        return (bytes + PageSize - 1) / PageSize * PageSize / element_size;
+    }
+};
+
+// Размер буфера округляется до класса размеров аллокатора (как в jemalloc: шаг 16 байт до 128,
+// дальше четыре класса на каждую степень двойки), чтобы не терять хвост выделенного блока
+template<typename Base = DoublingGrowth>
+struct SizeClassGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t bytes = Base::NextCapacity(capacity, required, element_size) * element_size;
+        return RoundToSizeClass(bytes) / element_size;
+    }
+
+    static size_t RoundToSizeClass(size_t bytes) noexcept {
+        size_t log2 = 0;
+
+        for (size_t rest = bytes > 1 ? bytes - 1 : 1; rest > 1; rest >>= 1) {
+            ++log2;
+        }
+
+        const size_t spacing = log2 < 6 ? 16 : size_t(1) << (log2 - 2);
+        return (bytes + spacing - 1) / spacing * spacing;
+    }
+};
+
+template<typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
 class Vector {
 public:
 
+    using value_type = T;
+    using allocator_type = AllocatorForT<T, Allocator>;
     using iterator = T*;
     using const_iterator = const T*;
 
     Vector() = default;
 
-    explicit Vector(size_t size);
+    explicit Vector(const allocator_type &alloc) noexcept: data_(alloc) {}
+
+    explicit Vector(size_t size, const allocator_type &alloc = allocator_type());
+
+    Vector(size_t size, DefaultInitT, const allocator_type &alloc = allocator_type());
 
     Vector(const Vector &other);
 
+    Vector(const Vector &other, const allocator_type &alloc);
+
     Vector(Vector &&other) noexcept: data_(std::move(other.data_)), size_(std::exchange(other.size_, 0)) {}
 
+    Vector(Vector &&other, const allocator_type &alloc);
+
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    Vector(InputIt first, InputIt last, const allocator_type &alloc = allocator_type());
+
+    Vector(std::initializer_list<T> items, const allocator_type &alloc = allocator_type())
+            : Vector(items.begin(), items.end(), alloc) {}
+
     ~Vector();
 
 
@@ -94,6 +329,19 @@ public:
 
     void Resize(size_t new_size) ;
 
+    // Перевыделяет буфер ровно под Size() элементов
+    void ShrinkToFit();
+
+    // Как Resize, но новые элементы инициализируются по умолчанию: тривиальные типы не обнуляются
+    void ResizeForOverwrite(size_t new_size);
+
+    // Расширяет вектор до max_size элементов, даёт op заполнить буфер и оставляет первые op(Data(), max_size)
+    template <typename Operation>
+    void ResizeAndOverwrite(size_t max_size, Operation op);
+
+    T *Data() noexcept {return data_.GetAddress();}
+    const T *Data() const noexcept {return data_.GetAddress();}
+
     template <typename Type>
     void PushBack(Type&& value);
 
@@ -108,24 +356,55 @@ public:
     iterator Insert(const_iterator pos, const T& item) {return Emplace(pos, item);}
     iterator Insert(const_iterator pos, T&& item) {return Emplace(pos, std::move(item));}
 
-    iterator Erase(const_iterator pos) {
+    // Диапазон не должен указывать на элементы самого вектора
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    iterator Insert(const_iterator pos, InputIt first, InputIt last);
+
+    iterator Insert(const_iterator pos, size_t count, const T& value);
+
+    iterator Insert(const_iterator pos, std::initializer_list<T> items) {
+        return Insert(pos, items.begin(), items.end());
+    }
+
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    void Append(InputIt first, InputIt last) {Insert(end(), first, last);}
 
-        assert(pos >= begin() && pos <= end());
-        int position = pos - begin();
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    void Assign(InputIt first, InputIt last);
 
-        std::move(begin() + position + 1, end(), begin() + position);
-        std::destroy_at(end() - 1);
-        size_-=1;
+    void Assign(size_t count, const T& value);
 
-        return (begin() + position);
+    void Assign(std::initializer_list<T> items) {Assign(items.begin(), items.end());}
+
+    void Clear() noexcept {
+        DestroyN(data_.GetAddress(), size_);
+        size_ = 0;
+    }
+
+    iterator Erase(const_iterator pos) {
+        assert(pos >= begin() && pos < end());
+        return Erase(pos, pos + 1);
     }
 
+    iterator Erase(const_iterator first, const_iterator last);
+
+    // Удаляет все элементы, удовлетворяющие pred, за один проход и возвращает их количество
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred);
+
+    // Удаляет элемент за O(1), ставя на его место последний; порядок элементов не сохраняется
+    iterator UnorderedErase(const_iterator pos);
+
 
 
     size_t Size() const noexcept;
 
     size_t Capacity() const noexcept;
 
+    allocator_type GetAllocator() const noexcept {return data_.GetAllocator();}
+
+    static constexpr size_t Alignment() noexcept {return RawMemory<T, Allocator>::Alignment();}
+
     void Swap(Vector &other) noexcept {
         data_.Swap(other.data_), std::swap(size_, other.size_);
     }
@@ -134,6 +413,16 @@ public:
 
         if (this != &other) {
 
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+
+                if (data_.GetAllocator() != other.data_.GetAllocator()) {
+                    DestroyN(data_.GetAddress(), size_);
+                    size_ = 0;
+                    data_ = RawMemory<T, Allocator>(data_.GetAllocator());
+                    data_.GetAllocator() = other.data_.GetAllocator();
+                }
+            }
+
             if (other.size_ <= data_.Capacity()) {
 
                 if (size_ <= other.size_) {
@@ -142,23 +431,23 @@ public:
                               other.data_.GetAddress() + size_,
                               data_.GetAddress());
 
-                    std::uninitialized_copy_n(other.data_.GetAddress() + size_,
-                                              other.size_ - size_,
-                                              data_.GetAddress() + size_);
+                    UninitializedCopyN(other.data_.GetAddress() + size_,
+                                       other.size_ - size_,
+                                       data_.GetAddress() + size_);
                 } else {
 
                     std::copy(other.data_.GetAddress(),
                               other.data_.GetAddress() + other.size_,
                               data_.GetAddress());
 
-                    std::destroy_n(data_.GetAddress() + other.size_,
-                                   size_ - other.size_);
+                    DestroyN(data_.GetAddress() + other.size_,
+                             size_ - other.size_);
                 }
 
                 size_ = other.size_;
 
             } else {
-                Vector other_copy(other);
+                Vector other_copy(other, data_.GetAllocator());
                 Swap(other_copy);
             }
         }
@@ -166,8 +455,24 @@ public:
         return *this;
     }
 
-    Vector &operator=(Vector &&other) noexcept {
-        Swap(other);
+    Vector &operator=(Vector &&other) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                                               || AllocTraits::is_always_equal::value) {
+
+        if (this != &other) {
+
+            if (AllocTraits::propagate_on_container_move_assignment::value
+                || data_.GetAllocator() == other.data_.GetAllocator()) {
+
+                DestroyN(data_.GetAddress(), size_);
+                data_ = std::move(other.data_);
+                size_ = std::exchange(other.size_, 0);
+
+            } else {
+                Vector other_copy(std::move(other), data_.GetAllocator());
+                Swap(other_copy);
+            }
+        }
+
         return *this;
     }
 
@@ -178,229 +483,732 @@ public:
 
 
 private:
-    static T *Allocate(size_t n);
+    using AllocTraits = std::allocator_traits<allocator_type>;
+    using Probe = VectorProbe<allocator_type>;
+
+    template <typename... Args>
+    void Construct(T *buf, Args&&... args);
 
-    static void Deallocate(T *buf) noexcept;
+    void Destroy(T *buf) noexcept;
 
-    static void DestroyN(T *buf, size_t n) noexcept;
+    void DestroyN(T *buf, size_t n) noexcept;
 
-    static void CopyConstruct(T *buf, const T &elem);
+    void UninitializedValueConstructN(T *buf, size_t n);
 
-    static void Destroy(T *buf) noexcept;
+    void UninitializedDefaultConstructN(T *buf, size_t n);
+
+    template <typename InputIt>
+    void UninitializedCopyN(InputIt first, size_t n, T *dest);
+
+    void Reallocate(RawMemory<T, Allocator> &new_data, size_t position, size_t gap);
+
+    template <typename... Args>
+    void EmplaceReallocatingInPlace(size_t position, size_t new_capacity, Args&&... args);
+
+    size_t NextCapacity(size_t required) const noexcept {
+        return GrowthPolicy::NextCapacity(data_.Capacity(), required, sizeof(T));
+    }
+
+    template <typename ForwardIt>
+    iterator InsertRange(size_t position, ForwardIt first, size_t count);
+
+    template <typename ForwardIt>
+    void AssignRange(ForwardIt first, size_t count);
+
+    bool Contains(const T *item) const noexcept {
+        return !std::less<const T *>()(item, begin()) && std::less<const T *>()(item, end());
+    }
+
+protected:
+    void ReallocateTo(size_t new_capacity);
+
+    // Для адаптеров, которые строят элементы сами: construct(end(), count) обязан построить ровно count
+    // элементов или бросить исключение, не оставив построенных
+    template <typename Operation>
+    void AppendUninitialized(size_t count, Operation construct);
+
+    // destroy(first, count) разрушает элементы начиная с new_size
+    template <typename Operation>
+    void TruncateWith(size_t new_size, Operation destroy) noexcept;
 
 private:
-    RawMemory<T> data_;
+    RawMemory<T, Allocator> data_;
     size_t size_ = 0;
 };
 
-template<typename T>
-void Vector<T>::PopBack() {
+namespace pmr {
+
+    template<typename T>
+    using Vector = ::Vector<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::PopBack() {
     assert(size_);
-    std::destroy_at(data_.GetAddress() + size_ - 1);
+    Destroy(data_.GetAddress() + size_ - 1);
     --size_;
 }
 
-template<typename T>
-void Vector<T>::Resize(size_t new_size) {
+template<typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::Resize(size_t new_size) {
 
     if (new_size < size_) {
-        std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
+        DestroyN(data_.GetAddress() + new_size, size_ - new_size);
 
     } else {
 
         if (new_size > data_.Capacity()) {
-            const size_t new_capacity = std::max(data_.Capacity() * 2, new_size);
+            Reserve(NextCapacity(new_size));
+        }
+
+        UninitializedValueConstructN(data_.GetAddress() + size_, new_size - size_);
+    }
+
+    size_ = new_size;
+}
 
-            Reserve(new_capacity);
+template<typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::ResizeForOverwrite(size_t new_size) {
+
+    if (new_size < size_) {
+        DestroyN(data_.GetAddress() + new_size, size_ - new_size);
+
+    } else {
+
+        if (new_size > data_.Capacity()) {
+            Reserve(NextCapacity(new_size));
         }
 
-        std::uninitialized_value_construct_n(data_.GetAddress() + size_, new_size - size_);
+        UninitializedDefaultConstructN(data_.GetAddress() + size_, new_size - size_);
     }
 
     size_ = new_size;
 }
 
-template<typename T>
-void Vector<T>::Destroy(T *buf) noexcept {
-    buf->~T();
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename Operation>
+void Vector<T, Allocator, GrowthPolicy>::ResizeAndOverwrite(size_t max_size, Operation op) {
+    const size_t old_size = size_;
+
+    if (max_size > old_size) {
+        ResizeForOverwrite(max_size);
+    }
+
+    size_t new_size;
+
+    try {
+        new_size = static_cast<size_t>(op(data_.GetAddress(), max_size));
+    } catch (...) {
+        DestroyN(data_.GetAddress() + old_size, size_ - old_size);
+        size_ = old_size;
+        throw;
+    }
+
+    assert(new_size <= max_size);
+    DestroyN(data_.GetAddress() + new_size, size_ - new_size);
+    size_ = new_size;
 }
 
-template<typename T>
-void Vector<T>::CopyConstruct(T *buf, const T &elem) {
-    new(buf) T(elem);
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename... Args>
+void Vector<T, Allocator, GrowthPolicy>::Construct(T *buf, Args&&... args) {
+    AllocTraits::construct(data_.GetAllocator(), buf, std::forward<Args>(args)...);
 }
 
-template<typename T>
-void Vector<T>::DestroyN(T *buf, size_t n) noexcept {
-    for (size_t i = 0; i != n; ++i) {
-        Destroy(buf + i);
+template<typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::Destroy(T *buf) noexcept {
+    AllocTraits::destroy(data_.GetAllocator(), buf);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::DestroyN(T *buf, size_t n) noexcept {
+
+    if constexpr (UsesPlacementConstructV<allocator_type, T>) {
+        std::destroy_n(buf, n);
+    } else {
+        for (size_t i = 0; i != n; ++i) {
+            Destroy(buf + i);
+        }
     }
 }
 
-template<typename T>
-void Vector<T>::Deallocate(T *buf) noexcept {
+template<typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::UninitializedValueConstructN(T *buf, size_t n) {
 
-    operator delete(buf);
+    if constexpr (UsesPlacementConstructV<allocator_type, T>) {
+        std::uninitialized_value_construct_n(buf, n);
+    } else {
+        size_t i = 0;
+
+        try {
+            for (; i != n; ++i) {
+                Construct(buf + i);
+            }
+        } catch (...) {
+            DestroyN(buf, i);
+            throw;
+        }
+    }
 }
 
-template<typename T>
-T *Vector<T>::Allocate(size_t n) {
-    return n != 0 ? static_cast<T *>(operator new(n * sizeof(T))) : nullptr;
+// Нетривиальные типы конструируются через аллокатор, как и при value-инициализации
+template<typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::UninitializedDefaultConstructN(T *buf, size_t n) {
+
+    if constexpr (std::is_trivially_default_constructible_v<T>) {
+        std::uninitialized_default_construct_n(buf, n);
+    } else {
+        UninitializedValueConstructN(buf, n);
+    }
 }
 
-template<typename T>
-T &Vector<T>::operator[](size_t index) noexcept {
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename InputIt>
+void Vector<T, Allocator, GrowthPolicy>::UninitializedCopyN(InputIt first, size_t n, T *dest) {
+
+    if constexpr (UsesPlacementConstructV<allocator_type, T>) {
+        std::uninitialized_copy_n(first, n, dest);
+    } else {
+        size_t i = 0;
+
+        try {
+            for (; i != n; ++i, ++first) {
+                Construct(dest + i, *first);
+            }
+        } catch (...) {
+            DestroyN(dest, i);
+            throw;
+        }
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+T &Vector<T, Allocator, GrowthPolicy>::operator[](size_t index) noexcept {
 
     assert(index < size_);
     return data_[index];
 }
 
-template<typename T>
-const T &Vector<T>::operator[](size_t index) const noexcept {
+template<typename T, typename Allocator, typename GrowthPolicy>
+const T &Vector<T, Allocator, GrowthPolicy>::operator[](size_t index) const noexcept {
     return const_cast<Vector &>(*this)[index];
 }
 
-template<typename T>
-size_t Vector<T>::Capacity() const noexcept {
+template<typename T, typename Allocator, typename GrowthPolicy>
+size_t Vector<T, Allocator, GrowthPolicy>::Capacity() const noexcept {
     return data_.Capacity();
 }
 
-template<typename T>
-size_t Vector<T>::Size() const noexcept {
+template<typename T, typename Allocator, typename GrowthPolicy>
+size_t Vector<T, Allocator, GrowthPolicy>::Size() const noexcept {
     return size_;
 }
 
-template<typename T>
-void Vector<T>::Reserve(size_t new_capacity) {
+template<typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::Reserve(size_t new_capacity) {
+
+    if (new_capacity > data_.Capacity()) {
+        ReallocateTo(new_capacity);
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::ShrinkToFit() {
+
+    if (data_.Capacity() > size_) {
+        ReallocateTo(size_);
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::ReallocateTo(size_t new_capacity) {
+    assert(new_capacity >= size_);
+
+    if constexpr (ReallocatesInPlaceV<allocator_type, T>) {
+
+        if (new_capacity != 0 && data_.Capacity() != 0) {
+            Probe::Released((data_.Capacity() - size_) * sizeof(T));
+            data_.Reallocate(new_capacity);
+            Probe::Reallocated();
+            Probe::Relocated(size_);
+            return;
+        }
+    }
+
+    RawMemory<T, Allocator> new_data(new_capacity, data_.GetAllocator());
+    Reallocate(new_data, size_, 0);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename Operation>
+void Vector<T, Allocator, GrowthPolicy>::AppendUninitialized(size_t count, Operation construct) {
+
+    if (size_ + count > data_.Capacity()) {
+        Reserve(NextCapacity(size_ + count));
+    }
+
+    construct(end(), count);
+    size_ += count;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename Operation>
+void Vector<T, Allocator, GrowthPolicy>::TruncateWith(size_t new_size, Operation destroy) noexcept {
+    assert(new_size <= size_);
+    destroy(data_.GetAddress() + new_size, size_ - new_size);
+    size_ = new_size;
+}
+
+// Элемент строится до расширения буфера, так как аргументы могут ссылаться на элементы вектора
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename... Args>
+void Vector<T, Allocator, GrowthPolicy>::EmplaceReallocatingInPlace(size_t position, size_t new_capacity, Args&&... args) {
+
+    alignas(T) unsigned char buf[sizeof(T)];
+    T *new_s = reinterpret_cast<T *>(buf);
+    Construct(new_s, std::forward<Args>(args)...);
+    const size_t old_capacity = data_.Capacity();
+
+    try {
+        data_.Reallocate(new_capacity);
+    } catch (...) {
+        Destroy(new_s);
+        throw;
+    }
 
-    if (new_capacity <= data_.Capacity()) {
-        return;
+    if (old_capacity != 0) {
+        Probe::Reallocated();
+        Probe::Relocated(size_);
     }
 
-    RawMemory<T> new_data(new_capacity);
+    RelocateWithin(begin() + position, size_ - position, begin() + position + 1);
+    std::memcpy(static_cast<void *>(begin() + position), buf, sizeof(T));
+}
+
+// Переносит элементы в new_data, оставляя gap свободных ячеек начиная с position, и забирает new_data себе
+template<typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::Reallocate(RawMemory<T, Allocator> &new_data, size_t position, size_t gap) {
+
+    T *old_buf = data_.GetAddress();
+    T *new_buf = new_data.GetAddress();
+
+    if constexpr (IsTriviallyRelocatableV<T>) {
+        UninitializedRelocateN(old_buf, position, new_buf);
+        UninitializedRelocateN(old_buf + position, size_ - position, new_buf + position + gap);
+
+    } else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+        UninitializedCopyN(std::make_move_iterator(old_buf), position, new_buf);
+
+        try {
+            UninitializedCopyN(std::make_move_iterator(old_buf + position), size_ - position,
+                               new_buf + position + gap);
+        } catch (...) {
+            DestroyN(new_buf, position);
+            throw;
+        }
+
+        DestroyN(old_buf, size_);
 
-    if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-        std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
     } else {
-        std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+        UninitializedCopyN(old_buf, position, new_buf);
+
+        try {
+            UninitializedCopyN(old_buf + position, size_ - position, new_buf + position + gap);
+        } catch (...) {
+            DestroyN(new_buf, position);
+            throw;
+        }
+
+        DestroyN(old_buf, size_);
+    }
+
+    if (data_.Capacity() != 0) {
+        Probe::Reallocated();
+        Probe::Released((data_.Capacity() - size_) * sizeof(T));
+
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            Probe::Relocated(size_);
+        } else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            Probe::Moved(size_);
+        } else {
+            Probe::Copied(size_);
+        }
     }
 
-    std::destroy_n(data_.GetAddress(), size_);
     data_.Swap(new_data);
 }
 
 
-template <typename T>
+template <typename T, typename Allocator, typename GrowthPolicy>
 template <typename Type>
-void Vector<T>::PushBack(Type&& value) {
+void Vector<T, Allocator, GrowthPolicy>::PushBack(Type&& value) {
+    EmplaceBack(std::forward<Type>(value));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+T& Vector<T, Allocator, GrowthPolicy>::EmplaceBack(Args&&... args) {
+
+    if constexpr (ReallocatesInPlaceV<allocator_type, T>) {
+
+        if (data_.Capacity() <= size_) {
+            EmplaceReallocatingInPlace(size_, NextCapacity(size_ + 1), std::forward<Args>(args)...);
+            return data_[size_++];
+        }
+    }
 
     if (data_.Capacity() <= size_) {
 
-        RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
+        RawMemory<T, Allocator> new_data(NextCapacity(size_ + 1), data_.GetAllocator());
 
-        new (new_data.GetAddress() + size_) T(std::forward<Type>(value));
+        Construct(new_data.GetAddress() + size_, std::forward<Args>(args)...);
 
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
-        } else {
-            std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+        try {
+            Reallocate(new_data, size_, 1);
+        } catch (...) {
+            Destroy(new_data.GetAddress() + size_);
+            throw;
         }
 
-        std::destroy_n(data_.GetAddress(), size_);
+    } else {
+        Construct(data_.GetAddress() + size_, std::forward<Args>(args)...);
+    }
+
+    return data_[size_++];
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::~Vector() {
+    DestroyN(data_.GetAddress(), size_);
+    Probe::Released((data_.Capacity() - size_) * sizeof(T));
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(const Vector &other)
+        : Vector(other, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator())) {
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(const Vector &other, const allocator_type &alloc)
+        : data_(other.size_, alloc) {
+    UninitializedCopyN(other.data_.GetAddress(), other.size_, data_.GetAddress());
+    size_ = other.size_;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(Vector &&other, const allocator_type &alloc)
+        : data_(alloc) {
+
+    if (data_.GetAllocator() == other.data_.GetAllocator()) {
+        data_.Swap(other.data_);
+        size_ = std::exchange(other.size_, 0);
+    } else {
+        RawMemory<T, Allocator> new_data(other.size_, alloc);
+        UninitializedCopyN(std::make_move_iterator(other.data_.GetAddress()), other.size_, new_data.GetAddress());
         data_.Swap(new_data);
+        size_ = other.size_;
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(size_t size, const allocator_type &alloc)
+        : data_(size, alloc) {
+    UninitializedValueConstructN(data_.GetAddress(), size);
+    size_ = size;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename InputIt, typename>
+Vector<T, Allocator, GrowthPolicy>::Vector(InputIt first, InputIt last, const allocator_type &alloc)
+        : data_(alloc) {
+
+    try {
+        Append(first, last);
+    } catch (...) {
+        DestroyN(data_.GetAddress(), size_);
+        throw;
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename InputIt, typename>
+typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::Insert(const_iterator pos, InputIt first, InputIt last) {
+    assert(pos >= begin() && pos <= end());
+    const size_t position = pos - begin();
+
+    if constexpr (IsForwardIteratorV<InputIt>) {
+        return InsertRange(position, first, static_cast<size_t>(std::distance(first, last)));
+
+    } else if (pos == end()) {
+
+        for (; first != last; ++first) {
+            EmplaceBack(*first);
+        }
+
+        return begin() + position;
 
     } else {
-        new (data_.GetAddress() + size_) T(std::forward<Type>(value));
+        Vector items(first, last, data_.GetAllocator());
+        return InsertRange(position, std::make_move_iterator(items.begin()), items.Size());
     }
+}
 
-    size_++;
+template<typename T, typename Allocator, typename GrowthPolicy>
+typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::Insert(const_iterator pos, size_t count, const T& value) {
+    assert(pos >= begin() && pos <= end());
+    const size_t position = pos - begin();
+
+    if (Contains(&value)) {
+        const T value_copy(value);
+        return InsertRange(position, RepeatIterator<T>(value_copy, 0), count);
+    }
+
+    return InsertRange(position, RepeatIterator<T>(value, 0), count);
 }
 
-template <typename T>
-template <typename... Args>
-T& Vector<T>::EmplaceBack(Args&&... args) {
+// Вставляет count элементов из first, выделяя память не более одного раза
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename ForwardIt>
+typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::InsertRange(size_t position, ForwardIt first, size_t count) {
 
-    if (data_.Capacity() <= size_) {
+    if (count == 0) {
+        return begin() + position;
+    }
 
-        RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
+    if (data_.Capacity() < size_ + count) {
 
-        new (new_data.GetAddress() + size_) T(std::forward<Args>(args)...);
+        RawMemory<T, Allocator> new_data(NextCapacity(size_ + count), data_.GetAllocator());
+
+        UninitializedCopyN(first, count, new_data.GetAddress() + position);
+
+        try {
+            Reallocate(new_data, position, count);
+        } catch (...) {
+            DestroyN(new_data.GetAddress() + position, count);
+            throw;
+        }
+
+    } else if (position == size_) {
+        UninitializedCopyN(first, count, end());
+
+    } else if constexpr (IsTriviallyRelocatableV<T>) {
+
+        T *pos_ptr = begin() + position;
+        RelocateWithin(pos_ptr, size_ - position, pos_ptr + count);
+
+        try {
+            UninitializedCopyN(first, count, pos_ptr);
+        } catch (...) {
+            RelocateWithin(pos_ptr + count, size_ - position, pos_ptr);
+            throw;
+        }
+
+    } else {
+
+        T *pos_ptr = begin() + position;
+        T *old_end = end();
+        const size_t tail = size_ - position;
+
+        if (tail > count) {
+            UninitializedCopyN(std::make_move_iterator(old_end - count), count, old_end);
+            size_ += count;
+
+            std::move_backward(pos_ptr, old_end - count, old_end);
+            std::copy_n(first, count, pos_ptr);
 
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
         } else {
-            std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+            ForwardIt mid = std::next(first, tail);
+            UninitializedCopyN(mid, count - tail, old_end);
+
+            try {
+                UninitializedCopyN(std::make_move_iterator(pos_ptr), tail, old_end + count - tail);
+            } catch (...) {
+                DestroyN(old_end, count - tail);
+                throw;
+            }
+
+            size_ += count;
+            std::copy(first, mid, pos_ptr);
         }
 
-        std::destroy_n(data_.GetAddress(), size_);
+        return begin() + position;
+    }
+
+    size_ += count;
+    return begin() + position;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename InputIt, typename>
+void Vector<T, Allocator, GrowthPolicy>::Assign(InputIt first, InputIt last) {
+
+    if constexpr (IsForwardIteratorV<InputIt>) {
+        AssignRange(first, static_cast<size_t>(std::distance(first, last)));
+    } else {
+        Clear();
+        Append(first, last);
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::Assign(size_t count, const T& value) {
+
+    if (Contains(&value)) {
+        const T value_copy(value);
+        AssignRange(RepeatIterator<T>(value_copy, 0), count);
+    } else {
+        AssignRange(RepeatIterator<T>(value, 0), count);
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename ForwardIt>
+void Vector<T, Allocator, GrowthPolicy>::AssignRange(ForwardIt first, size_t count) {
+
+    if (count > data_.Capacity()) {
+        RawMemory<T, Allocator> new_data(count, data_.GetAllocator());
+        UninitializedCopyN(first, count, new_data.GetAddress());
+
+        Clear();
         data_.Swap(new_data);
 
+    } else if (count > size_) {
+        ForwardIt mid = std::next(first, size_);
+        std::copy(first, mid, begin());
+        UninitializedCopyN(mid, count - size_, end());
+
     } else {
-        new (data_.GetAddress() + size_) T(std::forward<Args>(args)...);
+        std::copy_n(first, count, begin());
+        DestroyN(begin() + count, size_ - count);
     }
 
-    return data_[size_++];
+    size_ = count;
 }
 
-template<typename T>
-Vector<T>::~Vector() {
-    std::destroy_n(data_.GetAddress(), size_);
+template<typename T, typename Allocator, typename GrowthPolicy>
+typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::Erase(const_iterator first, const_iterator last) {
+    assert(first >= begin() && first <= last && last <= end());
+    const size_t position = first - begin();
+    const size_t count = last - first;
+
+    if (count == 0) {
+        return begin() + position;
+    }
+
+    T *first_ptr = begin() + position;
+
+    if constexpr (IsTriviallyRelocatableV<T>) {
+        DestroyN(first_ptr, count);
+        RelocateWithin(first_ptr + count, size_ - position - count, first_ptr);
+    } else {
+        std::move(first_ptr + count, end(), first_ptr);
+        DestroyN(end() - count, count);
+    }
+
+    size_ -= count;
+    return begin() + position;
 }
 
-template<typename T>
-Vector<T>::Vector(const Vector &other): data_(other.size_), size_(other.size_) {
-    std::uninitialized_copy_n(other.data_.GetAddress(), size_, data_.GetAddress());
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename Predicate>
+size_t Vector<T, Allocator, GrowthPolicy>::EraseIf(Predicate pred) {
+    const size_t old_size = size_;
+    Erase(std::remove_if(begin(), end(), pred), end());
+    return old_size - size_;
 }
 
-template<typename T>
-Vector<T>::Vector(size_t size)
-        : data_(size), size_(size) {
-    std::uninitialized_value_construct_n(data_.GetAddress(), size);
+template<typename T, typename Allocator, typename GrowthPolicy>
+typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::UnorderedErase(const_iterator pos) {
+    assert(pos >= begin() && pos < end());
+    T *pos_ptr = begin() + (pos - begin());
+    T *last = end() - 1;
+
+    if (pos_ptr != last) {
+
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            Destroy(pos_ptr);
+            RelocateWithin(last, 1, pos_ptr);
+            --size_;
+            return pos_ptr;
+        } else {
+            *pos_ptr = std::move(*last);
+        }
+    }
+
+    PopBack();
+    return pos_ptr;
 }
 
-template <typename T>
+template<typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(size_t size, DefaultInitT, const allocator_type &alloc)
+        : data_(size, alloc) {
+    UninitializedDefaultConstructN(data_.GetAddress(), size);
+    size_ = size;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
 template <typename... Args>
-typename Vector<T>::iterator Vector<T>::Emplace(const_iterator pos, Args&&... args) {
+typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::Emplace(const_iterator pos, Args&&... args) {
     assert(pos >= begin() && pos <= end());
-    int position = pos - begin();
+    const size_t position = pos - begin();
 
-    if (data_.Capacity() <= size_) {
+    if constexpr (ReallocatesInPlaceV<allocator_type, T>) {
 
-        RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
+        if (data_.Capacity() <= size_) {
+            EmplaceReallocatingInPlace(position, NextCapacity(size_ + 1), std::forward<Args>(args)...);
+            size_++;
+            return begin() + position;
+        }
+    }
 
-        new (new_data.GetAddress() + position) T(std::forward<Args>(args)...);
+    if (data_.Capacity() <= size_) {
 
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(data_.GetAddress(), position, new_data.GetAddress());
-            std::uninitialized_move_n(data_.GetAddress() + position, size_ - position, new_data.GetAddress() + position + 1);
+        RawMemory<T, Allocator> new_data(NextCapacity(size_ + 1), data_.GetAllocator());
 
-        } else {
-            std::uninitialized_copy_n(data_.GetAddress(), position, new_data.GetAddress());
-            std::uninitialized_copy_n(data_.GetAddress() + position, size_ - position, new_data.GetAddress() + position + 1);
+        Construct(new_data.GetAddress() + position, std::forward<Args>(args)...);
+
+        try {
+            Reallocate(new_data, position, 1);
+        } catch (...) {
+            Destroy(new_data.GetAddress() + position);
+            throw;
         }
 
-        std::destroy_n(data_.GetAddress(), size_);
-        data_.Swap(new_data);
+    } else if (pos == end()) {
+        Construct(end(), std::forward<Args>(args)...);
 
     } else {
 
-        try {
+        alignas(T) unsigned char buf[sizeof(T)];
+        T *new_s = reinterpret_cast<T *>(buf);
+        Construct(new_s, std::forward<Args>(args)...);
 
-            if (pos != end()) {
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            RelocateWithin(begin() + position, size_ - position, begin() + position + 1);
+            std::memcpy(static_cast<void *>(begin() + position), buf, sizeof(T));
 
-                T new_s(std::forward<Args>(args)...);
-                new (end()) T(std::forward<T>(data_[size_ - 1]));
+        } else {
 
-                std::move_backward(begin() + position, end() - 1, end());
-                *(begin() + position) = std::forward<T>(new_s);
+            try {
+                Construct(end(), std::move(data_[size_ - 1]));
+            } catch (...) {
+                Destroy(new_s);
+                throw;
+            }
 
-            } else {
-                new (end()) T(std::forward<Args>(args)...);
+            // Если сдвиг или присваивание бросили, лишний элемент за концом и новый элемент разрушаются,
+            // а в векторе остаются size_ элементов, часть из которых уже перемещена
+            try {
+                std::move_backward(begin() + position, end() - 1, end());
+                *(begin() + position) = std::move(*new_s);
+            } catch (...) {
+                Destroy(end());
+                Destroy(new_s);
+                throw;
             }
 
-        } catch (...) {
-            operator delete (end());
-            throw;
+            Destroy(new_s);
         }
     }
 
@@ -409,60 +1217,86 @@ typename Vector<T>::iterator Vector<T>::Emplace(const_iterator pos, Args&&... ar
 }
 
 
-template<typename T>
-void RawMemory<T>::Deallocate(T *buf) noexcept {
-    operator delete(buf);
+template<typename T, typename Allocator>
+void RawMemory<T, Allocator>::Deallocate(T *buf, size_t n) noexcept {
+
+    if (buf != nullptr) {
+        AllocTraits::deallocate(alloc_, buf, n);
+        Probe::Deallocated(n * sizeof(T));
+    }
 }
 
-template<typename T>
-T *RawMemory<T>::Allocate(size_t n) {
-    return n != 0 ? static_cast<T *>(operator new(n * sizeof(T))) : nullptr;
+template<typename T, typename Allocator>
+T *RawMemory<T, Allocator>::Allocate(size_t n) {
+
+    if (n == 0) {
+        return nullptr;
+    }
+
+    T *buf = AllocTraits::allocate(alloc_, n);
+    Probe::Allocated(n * sizeof(T));
+    return buf;
 }
 
-template<typename T>
-size_t RawMemory<T>::Capacity() const {
+// Доступно только аллокаторам с методом reallocate, содержимое буфера переносится побайтово
+template<typename T, typename Allocator>
+void RawMemory<T, Allocator>::Reallocate(size_t new_capacity) {
+    buffer_ = alloc_.reallocate(buffer_, capacity_, new_capacity);
+    Probe::Deallocated(capacity_ * sizeof(T));
+    Probe::Allocated(new_capacity * sizeof(T));
+    capacity_ = new_capacity;
+}
+
+template<typename T, typename Allocator>
+size_t RawMemory<T, Allocator>::Capacity() const {
     return capacity_;
 }
 
-template<typename T>
-T *RawMemory<T>::GetAddress() noexcept {
+template<typename T, typename Allocator>
+T *RawMemory<T, Allocator>::GetAddress() noexcept {
     return buffer_;
 }
 
-template<typename T>
-const T *RawMemory<T>::GetAddress() const noexcept {
+template<typename T, typename Allocator>
+const T *RawMemory<T, Allocator>::GetAddress() const noexcept {
     return buffer_;
 }
 
-template<typename T>
-void RawMemory<T>::Swap(RawMemory &other) noexcept {
+// Аллокаторы меняются местами, только если это разрешает propagate_on_container_swap
+template<typename T, typename Allocator>
+void RawMemory<T, Allocator>::Swap(RawMemory &other) noexcept {
+
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+        std::swap(alloc_, other.alloc_);
+    }
+
     std::swap(buffer_, other.buffer_);
     std::swap(capacity_, other.capacity_);
 }
 
-template<typename T>
-T &RawMemory<T>::operator[](size_t index) noexcept {
+template<typename T, typename Allocator>
+T &RawMemory<T, Allocator>::operator[](size_t index) noexcept {
     assert(index < capacity_);
     return buffer_[index];
 }
 
-template<typename T>
-const T &RawMemory<T>::operator[](size_t index) const noexcept {
+template<typename T, typename Allocator>
+const T &RawMemory<T, Allocator>::operator[](size_t index) const noexcept {
     return const_cast<RawMemory &>(*this)[index];
 }
 
-template<typename T>
-const T *RawMemory<T>::operator+(size_t offset) const noexcept {
+template<typename T, typename Allocator>
+const T *RawMemory<T, Allocator>::operator+(size_t offset) const noexcept {
     return const_cast<RawMemory &>(*this) + offset;
 }
 
-template<typename T>
-T *RawMemory<T>::operator+(size_t offset) noexcept {
+template<typename T, typename Allocator>
+T *RawMemory<T, Allocator>::operator+(size_t offset) noexcept {
     assert(offset <= capacity_);
     return buffer_ + offset;
 }
 
-template<typename T>
-RawMemory<T>::~RawMemory() {
-    Deallocate(buffer_);
+template<typename T, typename Allocator>
+RawMemory<T, Allocator>::~RawMemory() {
+    Deallocate(buffer_, capacity_);
 }
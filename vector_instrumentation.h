@@ -0,0 +1,262 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <ostream>
+#include <type_traits>
+
+// Счётчики выделений и переносов элементов в RawMemory и Vector. Собираются, только если
+// VECTOR_INSTRUMENTATION определён ненулевым до первого включения vector.h; иначе все хуки пустые
+// и компилятор выбрасывает их вместе с аргументами. Собранный подсчёт можно выключить во время работы.
+#ifndef VECTOR_INSTRUMENTATION
+#define VECTOR_INSTRUMENTATION 0
+#endif
+
+inline constexpr bool VECTOR_INSTRUMENTATION_ENABLED = VECTOR_INSTRUMENTATION != 0;
+
+// Снимок счётчиков одного тега. Размеры в байтах
+struct VectorStats {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t allocated_bytes = 0;
+    uint64_t live_bytes = 0;
+    uint64_t peak_live_bytes = 0;
+    // Самый большой отдельный буфер
+    uint64_t peak_buffer_bytes = 0;
+    // Перевыделения непустого буфера
+    uint64_t reallocations = 0;
+    // Элементы, перенесённые при перевыделении: побайтово, перемещением и копированием
+    uint64_t relocated_elements = 0;
+    uint64_t moved_elements = 0;
+    uint64_t copied_elements = 0;
+    // Неиспользованная вместимость буферов на момент их освобождения вектором
+    uint64_t wasted_bytes = 0;
+};
+
+// Атомарные счётчики одного тега. Создаются один раз на тег и сами регистрируются в VectorStatsRegistry
+class VectorCounters {
+public:
+    explicit VectorCounters(const char *name) noexcept;
+
+    VectorCounters(const VectorCounters &) = delete;
+
+    VectorCounters &operator=(const VectorCounters &) = delete;
+
+    const char *Name() const noexcept {return name_;}
+
+    VectorStats Snapshot() const noexcept;
+
+    void Reset() noexcept;
+
+    void Allocated(size_t bytes) noexcept;
+
+    void Deallocated(size_t bytes) noexcept;
+
+    void Reallocated() noexcept {Add(reallocations_, 1);}
+
+    void Relocated(size_t count) noexcept {Add(relocated_elements_, count);}
+
+    void Moved(size_t count) noexcept {Add(moved_elements_, count);}
+
+    void Copied(size_t count) noexcept {Add(copied_elements_, count);}
+
+    void Released(size_t unused_bytes) noexcept {Add(wasted_bytes_, unused_bytes);}
+
+private:
+    friend class VectorStatsRegistry;
+
+    using Counter = std::atomic<uint64_t>;
+
+    static void Add(Counter &counter, uint64_t value) noexcept {counter.fetch_add(value, std::memory_order_relaxed);}
+
+    static void UpdateMax(Counter &peak, uint64_t value) noexcept;
+
+    const char *name_;
+    VectorCounters *next_ = nullptr;
+
+    Counter allocations_{0};
+    Counter deallocations_{0};
+    Counter allocated_bytes_{0};
+    Counter live_bytes_{0};
+    Counter peak_live_bytes_{0};
+    Counter peak_buffer_bytes_{0};
+    Counter reallocations_{0};
+    Counter relocated_elements_{0};
+    Counter moved_elements_{0};
+    Counter copied_elements_{0};
+    Counter wasted_bytes_{0};
+};
+
+// Глобальный список счётчиков всех тегов, встречавшихся в программе
+class VectorStatsRegistry {
+public:
+    // f(const VectorCounters &) для каждого тега в порядке, обратном регистрации
+    template<typename Function>
+    static void ForEach(Function f);
+
+    // Одна строка на тег: имя и значения счётчиков
+    static void Dump(std::ostream &os);
+
+    static void Reset() noexcept;
+
+    // Пока подсчёт выключен, выделения и освобождения не учитываются, так что live_bytes после
+    // переключения приблизителен
+    static void SetEnabled(bool enabled) noexcept {enabled_.store(enabled, std::memory_order_relaxed);}
+
+    static bool Enabled() noexcept {return enabled_.load(std::memory_order_relaxed);}
+
+private:
+    friend class VectorCounters;
+
+    static void Register(VectorCounters &counters) noexcept;
+
+    inline static std::atomic<VectorCounters *> head_{nullptr};
+    inline static std::atomic<bool> enabled_{true};
+};
+
+// Тег векторов, чей аллокатор не задаёт instrumentation_tag
+struct UntaggedVectors {
+    static constexpr const char *NAME = "untagged";
+};
+
+template<typename Allocator, typename = void>
+struct InstrumentationTag {
+    using type = UntaggedVectors;
+};
+
+template<typename Allocator>
+struct InstrumentationTag<Allocator, std::void_t<typename Allocator::instrumentation_tag>> {
+    using type = typename Allocator::instrumentation_tag;
+};
+
+// Счётчики тега Tag; Tag задаёт имя в static constexpr const char *NAME
+template<typename Tag>
+VectorCounters &CountersForTag() noexcept {
+    static VectorCounters counters(Tag::NAME);
+    return counters;
+}
+
+// Хуки, которые вызывают RawMemory и Vector. Тег берётся из аллокатора
+template<typename Allocator>
+struct VectorProbe {
+    template<typename Function>
+    static void Record(Function f) noexcept {
+
+        if constexpr (VECTOR_INSTRUMENTATION_ENABLED) {
+
+            if (VectorStatsRegistry::Enabled()) {
+                f(CountersForTag<typename InstrumentationTag<Allocator>::type>());
+            }
+        } else {
+            (void)f;
+        }
+    }
+
+    static void Allocated(size_t bytes) noexcept {Record([bytes](VectorCounters &c) {c.Allocated(bytes);});}
+
+    static void Deallocated(size_t bytes) noexcept {Record([bytes](VectorCounters &c) {c.Deallocated(bytes);});}
+
+    static void Reallocated() noexcept {Record([](VectorCounters &c) {c.Reallocated();});}
+
+    static void Relocated(size_t count) noexcept {Record([count](VectorCounters &c) {c.Relocated(count);});}
+
+    static void Moved(size_t count) noexcept {Record([count](VectorCounters &c) {c.Moved(count);});}
+
+    static void Copied(size_t count) noexcept {Record([count](VectorCounters &c) {c.Copied(count);});}
+
+    static void Released(size_t unused_bytes) noexcept {
+        Record([unused_bytes](VectorCounters &c) {c.Released(unused_bytes);});
+    }
+};
+
+inline VectorCounters::VectorCounters(const char *name) noexcept
+        : name_(name) {
+    VectorStatsRegistry::Register(*this);
+}
+
+inline VectorStats VectorCounters::Snapshot() const noexcept {
+    VectorStats stats;
+    stats.allocations = allocations_.load(std::memory_order_relaxed);
+    stats.deallocations = deallocations_.load(std::memory_order_relaxed);
+    stats.allocated_bytes = allocated_bytes_.load(std::memory_order_relaxed);
+    stats.live_bytes = live_bytes_.load(std::memory_order_relaxed);
+    stats.peak_live_bytes = peak_live_bytes_.load(std::memory_order_relaxed);
+    stats.peak_buffer_bytes = peak_buffer_bytes_.load(std::memory_order_relaxed);
+    stats.reallocations = reallocations_.load(std::memory_order_relaxed);
+    stats.relocated_elements = relocated_elements_.load(std::memory_order_relaxed);
+    stats.moved_elements = moved_elements_.load(std::memory_order_relaxed);
+    stats.copied_elements = copied_elements_.load(std::memory_order_relaxed);
+    stats.wasted_bytes = wasted_bytes_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// Живые байты не сбрасываются: буферы, выделенные до сброса, ещё будут освобождены
+inline void VectorCounters::Reset() noexcept {
+
+    for (Counter *counter : {&allocations_, &deallocations_, &allocated_bytes_, &peak_buffer_bytes_, &reallocations_,
+                             &relocated_elements_, &moved_elements_, &copied_elements_, &wasted_bytes_}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+
+    peak_live_bytes_.store(live_bytes_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+inline void VectorCounters::Allocated(size_t bytes) noexcept {
+    Add(allocations_, 1);
+    Add(allocated_bytes_, bytes);
+    UpdateMax(peak_buffer_bytes_, bytes);
+    UpdateMax(peak_live_bytes_, live_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+}
+
+inline void VectorCounters::Deallocated(size_t bytes) noexcept {
+    Add(deallocations_, 1);
+    live_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+inline void VectorCounters::UpdateMax(Counter &peak, uint64_t value) noexcept {
+    uint64_t current = peak.load(std::memory_order_relaxed);
+
+    while (current < value && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+inline void VectorStatsRegistry::Register(VectorCounters &counters) noexcept {
+    VectorCounters *head = head_.load(std::memory_order_relaxed);
+
+    do {
+        counters.next_ = head;
+    } while (!head_.compare_exchange_weak(head, &counters, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template<typename Function>
+void VectorStatsRegistry::ForEach(Function f) {
+
+    for (VectorCounters *counters = head_.load(std::memory_order_acquire); counters != nullptr;
+         counters = counters->next_) {
+        f(static_cast<const VectorCounters &>(*counters));
+    }
+}
+
+inline void VectorStatsRegistry::Dump(std::ostream &os) {
+    ForEach([&os](const VectorCounters &counters) {
+        const VectorStats s = counters.Snapshot();
+
+        os << counters.Name()
+           << " allocations=" << s.allocations << " deallocations=" << s.deallocations
+           << " allocated_bytes=" << s.allocated_bytes << " live_bytes=" << s.live_bytes
+           << " peak_live_bytes=" << s.peak_live_bytes << " peak_buffer_bytes=" << s.peak_buffer_bytes
+           << " reallocations=" << s.reallocations << " relocated=" << s.relocated_elements
+           << " moved=" << s.moved_elements << " copied=" << s.copied_elements
+           << " wasted_bytes=" << s.wasted_bytes << '\n';
+    });
+}
+
+inline void VectorStatsRegistry::Reset() noexcept {
+
+    for (VectorCounters *counters = head_.load(std::memory_order_acquire); counters != nullptr;
+         counters = counters->next_) {
+        counters->Reset();
+    }
+}
@@ -0,0 +1,605 @@
+#pragma once
+
+#include "vector.h"
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define VECTOR_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+// Набор инструкций, которым пользуются числовые ядра. Уровень выбирается при первом вызове
+// по возможностям процессора и может быть понижен через SetSimdLevel, например в тестах.
+enum class SimdLevel {
+    Scalar,
+    Sse2,
+    Avx2,
+    Avx512,
+};
+
+inline SimdLevel DetectSimdLevel() noexcept {
+#ifdef VECTOR_KERNELS_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::Avx512;
+    }
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::Avx2;
+    }
+
+    if (__builtin_cpu_supports("sse2")) {
+        return SimdLevel::Sse2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+namespace kernels {
+
+    inline std::atomic<SimdLevel> &SimdLevelStorage() noexcept {
+        static std::atomic<SimdLevel> level{DetectSimdLevel()};
+        return level;
+    }
+
+} // namespace kernels
+
+inline SimdLevel ActiveSimdLevel() noexcept {
+    return kernels::SimdLevelStorage().load(std::memory_order_relaxed);
+}
+
+// Уровень выше поддерживаемого процессором понижается до поддерживаемого
+inline void SetSimdLevel(SimdLevel level) noexcept {
+    kernels::SimdLevelStorage().store(std::min(level, DetectSimdLevel()), std::memory_order_relaxed);
+}
+
+namespace kernels {
+
+    template<typename T>
+    inline constexpr bool IS_KERNEL_TYPE = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+    // Типы, для которых есть векторные реализации. Остальные арифметические типы идут через ScalarKernels
+    template<typename T>
+    inline constexpr bool HAS_SIMD = std::is_same_v<T, float> || std::is_same_v<T, double>
+                                     || std::is_same_v<T, int32_t>;
+
+    // Целочисленные ядра считают по модулю 2^N, как и векторные инструкции
+    template<typename T>
+    T WrapAdd(T a, T b) noexcept {
+        if constexpr (std::is_integral_v<T>) {
+            using U = std::make_unsigned_t<T>;
+            return static_cast<T>(static_cast<U>(static_cast<U>(a) + static_cast<U>(b)));
+        } else {
+            return a + b;
+        }
+    }
+
+    template<typename T>
+    T WrapMul(T a, T b) noexcept {
+        if constexpr (std::is_integral_v<T>) {
+            using U = std::conditional_t<sizeof(T) < sizeof(unsigned), unsigned, std::make_unsigned_t<T>>;
+            return static_cast<T>(static_cast<U>(static_cast<U>(a) * static_cast<U>(b)));
+        } else {
+            return a * b;
+        }
+    }
+
+    // Эталонные реализации: простые циклы, с которыми сверяются векторные версии.
+    // Порядок сложения в векторных версиях другой, поэтому для float и double результаты
+    // сумм могут отличаться в последних разрядах.
+    struct ScalarKernels {
+        template<typename T>
+        static T Sum(const T *data, size_t n) noexcept {
+            T sum = T();
+            for (size_t i = 0; i != n; ++i) {
+                sum = WrapAdd(sum, data[i]);
+            }
+            return sum;
+        }
+
+        template<typename T>
+        static T Min(const T *data, size_t n) noexcept {
+            assert(n != 0);
+            T result = data[0];
+            for (size_t i = 1; i != n; ++i) {
+                result = std::min(result, data[i]);
+            }
+            return result;
+        }
+
+        template<typename T>
+        static T Max(const T *data, size_t n) noexcept {
+            assert(n != 0);
+            T result = data[0];
+            for (size_t i = 1; i != n; ++i) {
+                result = std::max(result, data[i]);
+            }
+            return result;
+        }
+
+        template<typename T>
+        static T Dot(const T *a, const T *b, size_t n) noexcept {
+            T sum = T();
+            for (size_t i = 0; i != n; ++i) {
+                sum = WrapAdd(sum, WrapMul(a[i], b[i]));
+            }
+            return sum;
+        }
+
+        template<typename T>
+        static void Add(const T *a, const T *b, T *out, size_t n) noexcept {
+            for (size_t i = 0; i != n; ++i) {
+                out[i] = WrapAdd(a[i], b[i]);
+            }
+        }
+
+        template<typename T>
+        static void Mul(const T *a, const T *b, T *out, size_t n) noexcept {
+            for (size_t i = 0; i != n; ++i) {
+                out[i] = WrapMul(a[i], b[i]);
+            }
+        }
+
+        template<typename T>
+        static void Fma(const T *a, const T *b, const T *c, T *out, size_t n) noexcept {
+            for (size_t i = 0; i != n; ++i) {
+                out[i] = WrapAdd(WrapMul(a[i], b[i]), c[i]);
+            }
+        }
+
+        template<typename T>
+        static void ScaledCopy(const T *src, T scale, T *dst, size_t n) noexcept {
+            for (size_t i = 0; i != n; ++i) {
+                dst[i] = WrapMul(src[i], scale);
+            }
+        }
+
+        template<typename T>
+        static size_t Find(const T *data, size_t n, T value) noexcept {
+            for (size_t i = 0; i != n; ++i) {
+                if (data[i] == value) {
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        template<typename T>
+        static size_t Count(const T *data, size_t n, T value) noexcept {
+            size_t count = 0;
+            for (size_t i = 0; i != n; ++i) {
+                count += data[i] == value;
+            }
+            return count;
+        }
+
+        template<typename T>
+        static void PrefixSum(const T *in, T *out, size_t n) noexcept {
+            for (size_t i = 0; i != n; ++i) {
+                out[i] = i == 0 ? in[i] : WrapAdd(out[i - 1], in[i]);
+            }
+        }
+    };
+
+} // namespace kernels
+
+#ifdef VECTOR_KERNELS_X86
+
+// Каждый набор инструкций компилируется в своей области target, поэтому файл не требует флагов -m*
+// и работает на любом x86-процессоре: неподдерживаемые ветки просто не вызываются.
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+namespace kernels::sse2 {
+
+    template<typename T>
+    struct Simd;
+
+    template<>
+    struct Simd<float> {
+        using Reg = __m128;
+        static constexpr size_t WIDTH = 4;
+
+        static Reg Load(const float *p) noexcept {return _mm_loadu_ps(p);}
+        static void Store(float *p, Reg x) noexcept {_mm_storeu_ps(p, x);}
+        static Reg Set1(float value) noexcept {return _mm_set1_ps(value);}
+        static Reg Zero() noexcept {return _mm_setzero_ps();}
+        static Reg Add(Reg a, Reg b) noexcept {return _mm_add_ps(a, b);}
+        static Reg Mul(Reg a, Reg b) noexcept {return _mm_mul_ps(a, b);}
+        static Reg Fma(Reg a, Reg b, Reg c) noexcept {return _mm_add_ps(_mm_mul_ps(a, b), c);}
+        static Reg Min(Reg a, Reg b) noexcept {return _mm_min_ps(a, b);}
+        static Reg Max(Reg a, Reg b) noexcept {return _mm_max_ps(a, b);}
+        static unsigned EqMask(Reg a, Reg b) noexcept {return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(a, b)));}
+
+        static Reg ShiftUp(Reg x, size_t lanes) noexcept {
+            const __m128i bits = _mm_castps_si128(x);
+            return _mm_castsi128_ps(lanes == 1 ? _mm_slli_si128(bits, 4) : _mm_slli_si128(bits, 8));
+        }
+    };
+
+    template<>
+    struct Simd<double> {
+        using Reg = __m128d;
+        static constexpr size_t WIDTH = 2;
+
+        static Reg Load(const double *p) noexcept {return _mm_loadu_pd(p);}
+        static void Store(double *p, Reg x) noexcept {_mm_storeu_pd(p, x);}
+        static Reg Set1(double value) noexcept {return _mm_set1_pd(value);}
+        static Reg Zero() noexcept {return _mm_setzero_pd();}
+        static Reg Add(Reg a, Reg b) noexcept {return _mm_add_pd(a, b);}
+        static Reg Mul(Reg a, Reg b) noexcept {return _mm_mul_pd(a, b);}
+        static Reg Fma(Reg a, Reg b, Reg c) noexcept {return _mm_add_pd(_mm_mul_pd(a, b), c);}
+        static Reg Min(Reg a, Reg b) noexcept {return _mm_min_pd(a, b);}
+        static Reg Max(Reg a, Reg b) noexcept {return _mm_max_pd(a, b);}
+        static unsigned EqMask(Reg a, Reg b) noexcept {return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(a, b)));}
+
+        static Reg ShiftUp(Reg x, size_t) noexcept {
+            return _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8));
+        }
+    };
+
+    template<>
+    struct Simd<int32_t> {
+        using Reg = __m128i;
+        static constexpr size_t WIDTH = 4;
+
+        static Reg Load(const int32_t *p) noexcept {return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));}
+        static void Store(int32_t *p, Reg x) noexcept {_mm_storeu_si128(reinterpret_cast<__m128i *>(p), x);}
+        static Reg Set1(int32_t value) noexcept {return _mm_set1_epi32(value);}
+        static Reg Zero() noexcept {return _mm_setzero_si128();}
+        static Reg Add(Reg a, Reg b) noexcept {return _mm_add_epi32(a, b);}
+        static Reg Fma(Reg a, Reg b, Reg c) noexcept {return _mm_add_epi32(Mul(a, b), c);}
+        static unsigned EqMask(Reg a, Reg b) noexcept {
+            return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))));
+        }
+
+        // В SSE2 нет mullo_epi32: чётные и нечётные элементы умножаются отдельно через mul_epu32
+        static Reg Mul(Reg a, Reg b) noexcept {
+            const __m128i even = _mm_mul_epu32(a, b);
+            const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+            return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                      _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        }
+
+        // И min_epi32/max_epi32 появились только в SSE4.1
+        static Reg Min(Reg a, Reg b) noexcept {
+            const __m128i a_greater = _mm_cmpgt_epi32(a, b);
+            return _mm_or_si128(_mm_and_si128(a_greater, b), _mm_andnot_si128(a_greater, a));
+        }
+
+        static Reg Max(Reg a, Reg b) noexcept {
+            const __m128i a_greater = _mm_cmpgt_epi32(a, b);
+            return _mm_or_si128(_mm_and_si128(a_greater, a), _mm_andnot_si128(a_greater, b));
+        }
+
+        static Reg ShiftUp(Reg x, size_t lanes) noexcept {
+            return lanes == 1 ? _mm_slli_si128(x, 4) : _mm_slli_si128(x, 8);
+        }
+    };
+
+    using ScalarKernels = kernels::ScalarKernels;
+    using kernels::WrapAdd;
+
+#include "vector_kernels_impl.h"
+
+} // namespace kernels::sse2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#pragma GCC pop_options
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+
+namespace kernels::avx2 {
+
+    // Сдвиг восьми 32-битных элементов к старшим индексам с заполнением нулями, через границу 128-битных половин
+    inline __m256i ShiftUp32(__m256i x, size_t lanes) noexcept {
+        const __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i shift = _mm256_set1_epi32(static_cast<int>(lanes));
+        const __m256i moved = _mm256_permutevar8x32_epi32(x, _mm256_sub_epi32(index, shift));
+        return _mm256_and_si256(moved, _mm256_cmpgt_epi32(index, _mm256_sub_epi32(shift, _mm256_set1_epi32(1))));
+    }
+
+    template<typename T>
+    struct Simd;
+
+    template<>
+    struct Simd<float> {
+        using Reg = __m256;
+        static constexpr size_t WIDTH = 8;
+
+        static Reg Load(const float *p) noexcept {return _mm256_loadu_ps(p);}
+        static void Store(float *p, Reg x) noexcept {_mm256_storeu_ps(p, x);}
+        static Reg Set1(float value) noexcept {return _mm256_set1_ps(value);}
+        static Reg Zero() noexcept {return _mm256_setzero_ps();}
+        static Reg Add(Reg a, Reg b) noexcept {return _mm256_add_ps(a, b);}
+        static Reg Mul(Reg a, Reg b) noexcept {return _mm256_mul_ps(a, b);}
+        static Reg Fma(Reg a, Reg b, Reg c) noexcept {return _mm256_fmadd_ps(a, b, c);}
+        static Reg Min(Reg a, Reg b) noexcept {return _mm256_min_ps(a, b);}
+        static Reg Max(Reg a, Reg b) noexcept {return _mm256_max_ps(a, b);}
+        static unsigned EqMask(Reg a, Reg b) noexcept {
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+        }
+        static Reg ShiftUp(Reg x, size_t lanes) noexcept {
+            return _mm256_castsi256_ps(ShiftUp32(_mm256_castps_si256(x), lanes));
+        }
+    };
+
+    template<>
+    struct Simd<double> {
+        using Reg = __m256d;
+        static constexpr size_t WIDTH = 4;
+
+        static Reg Load(const double *p) noexcept {return _mm256_loadu_pd(p);}
+        static void Store(double *p, Reg x) noexcept {_mm256_storeu_pd(p, x);}
+        static Reg Set1(double value) noexcept {return _mm256_set1_pd(value);}
+        static Reg Zero() noexcept {return _mm256_setzero_pd();}
+        static Reg Add(Reg a, Reg b) noexcept {return _mm256_add_pd(a, b);}
+        static Reg Mul(Reg a, Reg b) noexcept {return _mm256_mul_pd(a, b);}
+        static Reg Fma(Reg a, Reg b, Reg c) noexcept {return _mm256_fmadd_pd(a, b, c);}
+        static Reg Min(Reg a, Reg b) noexcept {return _mm256_min_pd(a, b);}
+        static Reg Max(Reg a, Reg b) noexcept {return _mm256_max_pd(a, b);}
+        static unsigned EqMask(Reg a, Reg b) noexcept {
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+        }
+        static Reg ShiftUp(Reg x, size_t lanes) noexcept {
+            return _mm256_castsi256_pd(ShiftUp32(_mm256_castpd_si256(x), 2 * lanes));
+        }
+    };
+
+    template<>
+    struct Simd<int32_t> {
+        using Reg = __m256i;
+        static constexpr size_t WIDTH = 8;
+
+        static Reg Load(const int32_t *p) noexcept {return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));}
+        static void Store(int32_t *p, Reg x) noexcept {_mm256_storeu_si256(reinterpret_cast<__m256i *>(p), x);}
+        static Reg Set1(int32_t value) noexcept {return _mm256_set1_epi32(value);}
+        static Reg Zero() noexcept {return _mm256_setzero_si256();}
+        static Reg Add(Reg a, Reg b) noexcept {return _mm256_add_epi32(a, b);}
+        static Reg Mul(Reg a, Reg b) noexcept {return _mm256_mullo_epi32(a, b);}
+        static Reg Fma(Reg a, Reg b, Reg c) noexcept {return _mm256_add_epi32(_mm256_mullo_epi32(a, b), c);}
+        static Reg Min(Reg a, Reg b) noexcept {return _mm256_min_epi32(a, b);}
+        static Reg Max(Reg a, Reg b) noexcept {return _mm256_max_epi32(a, b);}
+        static unsigned EqMask(Reg a, Reg b) noexcept {
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))));
+        }
+        static Reg ShiftUp(Reg x, size_t lanes) noexcept {return ShiftUp32(x, lanes);}
+    };
+
+    using ScalarKernels = kernels::ScalarKernels;
+    using kernels::WrapAdd;
+
+#include "vector_kernels_impl.h"
+
+} // namespace kernels::avx2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#else
+#pragma GCC pop_options
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+// GCC 12 считает _mm512_undefined_* неинициализированным значением внутри встроенных функций
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace kernels::avx512 {
+
+    inline __m512i ShiftUp32(__m512i x, size_t lanes) noexcept {
+        const __m512i index = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i source = _mm512_sub_epi32(index, _mm512_set1_epi32(static_cast<int>(lanes)));
+        return _mm512_maskz_permutexvar_epi32(static_cast<__mmask16>(0xFFFFu << lanes), source, x);
+    }
+
+    template<typename T>
+    struct Simd;
+
+    template<>
+    struct Simd<float> {
+        using Reg = __m512;
+        static constexpr size_t WIDTH = 16;
+
+        static Reg Load(const float *p) noexcept {return _mm512_loadu_ps(p);}
+        static void Store(float *p, Reg x) noexcept {_mm512_storeu_ps(p, x);}
+        static Reg Set1(float value) noexcept {return _mm512_set1_ps(value);}
+        static Reg Zero() noexcept {return _mm512_setzero_ps();}
+        static Reg Add(Reg a, Reg b) noexcept {return _mm512_add_ps(a, b);}
+        static Reg Mul(Reg a, Reg b) noexcept {return _mm512_mul_ps(a, b);}
+        static Reg Fma(Reg a, Reg b, Reg c) noexcept {return _mm512_fmadd_ps(a, b, c);}
+        static Reg Min(Reg a, Reg b) noexcept {return _mm512_min_ps(a, b);}
+        static Reg Max(Reg a, Reg b) noexcept {return _mm512_max_ps(a, b);}
+        static unsigned EqMask(Reg a, Reg b) noexcept {return _mm512_cmpeq_ps_mask(a, b);}
+        static Reg ShiftUp(Reg x, size_t lanes) noexcept {
+            return _mm512_castsi512_ps(ShiftUp32(_mm512_castps_si512(x), lanes));
+        }
+    };
+
+    template<>
+    struct Simd<double> {
+        using Reg = __m512d;
+        static constexpr size_t WIDTH = 8;
+
+        static Reg Load(const double *p) noexcept {return _mm512_loadu_pd(p);}
+        static void Store(double *p, Reg x) noexcept {_mm512_storeu_pd(p, x);}
+        static Reg Set1(double value) noexcept {return _mm512_set1_pd(value);}
+        static Reg Zero() noexcept {return _mm512_setzero_pd();}
+        static Reg Add(Reg a, Reg b) noexcept {return _mm512_add_pd(a, b);}
+        static Reg Mul(Reg a, Reg b) noexcept {return _mm512_mul_pd(a, b);}
+        static Reg Fma(Reg a, Reg b, Reg c) noexcept {return _mm512_fmadd_pd(a, b, c);}
+        static Reg Min(Reg a, Reg b) noexcept {return _mm512_min_pd(a, b);}
+        static Reg Max(Reg a, Reg b) noexcept {return _mm512_max_pd(a, b);}
+        static unsigned EqMask(Reg a, Reg b) noexcept {return _mm512_cmpeq_pd_mask(a, b);}
+        static Reg ShiftUp(Reg x, size_t lanes) noexcept {
+            return _mm512_castsi512_pd(ShiftUp32(_mm512_castpd_si512(x), 2 * lanes));
+        }
+    };
+
+    template<>
+    struct Simd<int32_t> {
+        using Reg = __m512i;
+        static constexpr size_t WIDTH = 16;
+
+        static Reg Load(const int32_t *p) noexcept {return _mm512_loadu_si512(p);}
+        static void Store(int32_t *p, Reg x) noexcept {_mm512_storeu_si512(p, x);}
+        static Reg Set1(int32_t value) noexcept {return _mm512_set1_epi32(value);}
+        static Reg Zero() noexcept {return _mm512_setzero_si512();}
+        static Reg Add(Reg a, Reg b) noexcept {return _mm512_add_epi32(a, b);}
+        static Reg Mul(Reg a, Reg b) noexcept {return _mm512_mullo_epi32(a, b);}
+        static Reg Fma(Reg a, Reg b, Reg c) noexcept {return _mm512_add_epi32(_mm512_mullo_epi32(a, b), c);}
+        static Reg Min(Reg a, Reg b) noexcept {return _mm512_min_epi32(a, b);}
+        static Reg Max(Reg a, Reg b) noexcept {return _mm512_max_epi32(a, b);}
+        static unsigned EqMask(Reg a, Reg b) noexcept {return _mm512_cmpeq_epi32_mask(a, b);}
+        static Reg ShiftUp(Reg x, size_t lanes) noexcept {return ShiftUp32(x, lanes);}
+    };
+
+    using ScalarKernels = kernels::ScalarKernels;
+    using kernels::WrapAdd;
+
+#include "vector_kernels_impl.h"
+
+} // namespace kernels::avx512
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+#endif
+
+#endif // VECTOR_KERNELS_X86
+
+namespace kernels {
+
+    // Вызывает kernel с набором ядер активного уровня. Лямбда получает объект набора и обращается
+    // к его статическим функциям, поэтому одна лямбда обслуживает все уровни.
+    template<typename T, typename Kernel>
+    auto Dispatch(Kernel kernel) {
+        static_assert(IS_KERNEL_TYPE<T>, "kernels work with arithmetic types");
+
+#ifdef VECTOR_KERNELS_X86
+        if constexpr (HAS_SIMD<T>) {
+            switch (ActiveSimdLevel()) {
+                case SimdLevel::Avx512:
+                    return kernel(avx512::IsaKernels{});
+                case SimdLevel::Avx2:
+                    return kernel(avx2::IsaKernels{});
+                case SimdLevel::Sse2:
+                    return kernel(sse2::IsaKernels{});
+                case SimdLevel::Scalar:
+                    break;
+            }
+        }
+#endif
+
+        return kernel(ScalarKernels{});
+    }
+
+    template<typename T>
+    T Sum(const T *data, size_t n) noexcept {
+        return Dispatch<T>([&](auto isa) {return decltype(isa)::Sum(data, n);});
+    }
+
+    // Для пустого диапазона не определены. Результат с NaN зависит от уровня
+    template<typename T>
+    T Min(const T *data, size_t n) noexcept {
+        assert(n != 0);
+        return Dispatch<T>([&](auto isa) {return decltype(isa)::Min(data, n);});
+    }
+
+    template<typename T>
+    T Max(const T *data, size_t n) noexcept {
+        assert(n != 0);
+        return Dispatch<T>([&](auto isa) {return decltype(isa)::Max(data, n);});
+    }
+
+    template<typename T>
+    T Dot(const T *a, const T *b, size_t n) noexcept {
+        return Dispatch<T>([&](auto isa) {return decltype(isa)::Dot(a, b, n);});
+    }
+
+    // Поэлементные ядра допускают out, совпадающий с одним из входов
+    template<typename T>
+    void Add(const T *a, const T *b, T *out, size_t n) noexcept {
+        Dispatch<T>([&](auto isa) {decltype(isa)::Add(a, b, out, n);});
+    }
+
+    template<typename T>
+    void Mul(const T *a, const T *b, T *out, size_t n) noexcept {
+        Dispatch<T>([&](auto isa) {decltype(isa)::Mul(a, b, out, n);});
+    }
+
+    // out[i] = a[i] * b[i] + c[i]. На AVX2 и AVX-512 для float и double — с одним округлением
+    template<typename T>
+    void Fma(const T *a, const T *b, const T *c, T *out, size_t n) noexcept {
+        Dispatch<T>([&](auto isa) {decltype(isa)::Fma(a, b, c, out, n);});
+    }
+
+    template<typename T>
+    void ScaledCopy(const T *src, T scale, T *dst, size_t n) noexcept {
+        Dispatch<T>([&](auto isa) {decltype(isa)::ScaledCopy(src, scale, dst, n);});
+    }
+
+    // Индекс первого элемента, равного value, или n
+    template<typename T>
+    size_t Find(const T *data, size_t n, T value) noexcept {
+        return Dispatch<T>([&](auto isa) {return decltype(isa)::Find(data, n, value);});
+    }
+
+    template<typename T>
+    size_t Count(const T *data, size_t n, T value) noexcept {
+        return Dispatch<T>([&](auto isa) {return decltype(isa)::Count(data, n, value);});
+    }
+
+    // Включающая префиксная сумма, out может совпадать с in
+    template<typename T>
+    void PrefixSum(const T *in, T *out, size_t n) noexcept {
+        Dispatch<T>([&](auto isa) {decltype(isa)::PrefixSum(in, out, n);});
+    }
+
+    template<typename T, typename Allocator, typename GrowthPolicy>
+    T Sum(const Vector<T, Allocator, GrowthPolicy> &v) noexcept {
+        return Sum(v.Data(), v.Size());
+    }
+
+    template<typename T, typename Allocator, typename GrowthPolicy>
+    T Min(const Vector<T, Allocator, GrowthPolicy> &v) noexcept {
+        return Min(v.Data(), v.Size());
+    }
+
+    template<typename T, typename Allocator, typename GrowthPolicy>
+    T Max(const Vector<T, Allocator, GrowthPolicy> &v) noexcept {
+        return Max(v.Data(), v.Size());
+    }
+
+    template<typename T, typename Allocator, typename GrowthPolicy>
+    T Dot(const Vector<T, Allocator, GrowthPolicy> &a, const Vector<T, Allocator, GrowthPolicy> &b) noexcept {
+        assert(a.Size() == b.Size());
+        return Dot(a.Data(), b.Data(), a.Size());
+    }
+
+    template<typename T, typename Allocator, typename GrowthPolicy>
+    size_t Find(const Vector<T, Allocator, GrowthPolicy> &v, T value) noexcept {
+        return Find(v.Data(), v.Size(), value);
+    }
+
+    template<typename T, typename Allocator, typename GrowthPolicy>
+    size_t Count(const Vector<T, Allocator, GrowthPolicy> &v, T value) noexcept {
+        return Count(v.Data(), v.Size(), value);
+    }
+
+} // namespace kernels
@@ -0,0 +1,206 @@
+// Тела SIMD-ядер. Файл намеренно без #pragma once: vector_kernels.h включает его по разу
+// в пространство имён каждого набора инструкций, где уже объявлен Simd<T> и включён нужный target.
+// Simd<T> задаёт тип регистра Reg, число элементов WIDTH и операции Load, Store, Set1, Zero, Add, Mul,
+// Fma, Min, Max, EqMask (битовая маска равных элементов) и ShiftUp (сдвиг элементов к старшим индексам).
+
+struct IsaKernels {
+    template<typename T>
+    static T Sum(const T *data, size_t n) noexcept {
+        using S = Simd<T>;
+        constexpr size_t W = S::WIDTH;
+
+        // Четыре независимых аккумулятора скрывают задержку сложения
+        typename S::Reg acc0 = S::Zero(), acc1 = S::Zero(), acc2 = S::Zero(), acc3 = S::Zero();
+        size_t i = 0;
+
+        for (; i + 4 * W <= n; i += 4 * W) {
+            acc0 = S::Add(acc0, S::Load(data + i));
+            acc1 = S::Add(acc1, S::Load(data + i + W));
+            acc2 = S::Add(acc2, S::Load(data + i + 2 * W));
+            acc3 = S::Add(acc3, S::Load(data + i + 3 * W));
+        }
+
+        for (; i + W <= n; i += W) {
+            acc0 = S::Add(acc0, S::Load(data + i));
+        }
+
+        T lanes[W];
+        S::Store(lanes, S::Add(S::Add(acc0, acc1), S::Add(acc2, acc3)));
+
+        return WrapAdd(ScalarKernels::Sum(lanes, W), ScalarKernels::Sum(data + i, n - i));
+    }
+
+    template<typename T>
+    static T Min(const T *data, size_t n) noexcept {
+        using S = Simd<T>;
+        constexpr size_t W = S::WIDTH;
+
+        if (n < W) {
+            return ScalarKernels::Min(data, n);
+        }
+
+        typename S::Reg acc = S::Load(data);
+        size_t i = W;
+
+        for (; i + W <= n; i += W) {
+            acc = S::Min(acc, S::Load(data + i));
+        }
+
+        T lanes[W];
+        S::Store(lanes, acc);
+        const T result = ScalarKernels::Min(lanes, W);
+
+        return i == n ? result : std::min(result, ScalarKernels::Min(data + i, n - i));
+    }
+
+    template<typename T>
+    static T Max(const T *data, size_t n) noexcept {
+        using S = Simd<T>;
+        constexpr size_t W = S::WIDTH;
+
+        if (n < W) {
+            return ScalarKernels::Max(data, n);
+        }
+
+        typename S::Reg acc = S::Load(data);
+        size_t i = W;
+
+        for (; i + W <= n; i += W) {
+            acc = S::Max(acc, S::Load(data + i));
+        }
+
+        T lanes[W];
+        S::Store(lanes, acc);
+        const T result = ScalarKernels::Max(lanes, W);
+
+        return i == n ? result : std::max(result, ScalarKernels::Max(data + i, n - i));
+    }
+
+    template<typename T>
+    static T Dot(const T *a, const T *b, size_t n) noexcept {
+        using S = Simd<T>;
+        constexpr size_t W = S::WIDTH;
+
+        typename S::Reg acc0 = S::Zero(), acc1 = S::Zero();
+        size_t i = 0;
+
+        for (; i + 2 * W <= n; i += 2 * W) {
+            acc0 = S::Fma(S::Load(a + i), S::Load(b + i), acc0);
+            acc1 = S::Fma(S::Load(a + i + W), S::Load(b + i + W), acc1);
+        }
+
+        for (; i + W <= n; i += W) {
+            acc0 = S::Fma(S::Load(a + i), S::Load(b + i), acc0);
+        }
+
+        T lanes[W];
+        S::Store(lanes, S::Add(acc0, acc1));
+
+        return WrapAdd(ScalarKernels::Sum(lanes, W), ScalarKernels::Dot(a + i, b + i, n - i));
+    }
+
+    template<typename T>
+    static void Add(const T *a, const T *b, T *out, size_t n) noexcept {
+        using S = Simd<T>;
+        size_t i = 0;
+
+        for (; i + S::WIDTH <= n; i += S::WIDTH) {
+            S::Store(out + i, S::Add(S::Load(a + i), S::Load(b + i)));
+        }
+
+        ScalarKernels::Add(a + i, b + i, out + i, n - i);
+    }
+
+    template<typename T>
+    static void Mul(const T *a, const T *b, T *out, size_t n) noexcept {
+        using S = Simd<T>;
+        size_t i = 0;
+
+        for (; i + S::WIDTH <= n; i += S::WIDTH) {
+            S::Store(out + i, S::Mul(S::Load(a + i), S::Load(b + i)));
+        }
+
+        ScalarKernels::Mul(a + i, b + i, out + i, n - i);
+    }
+
+    template<typename T>
+    static void Fma(const T *a, const T *b, const T *c, T *out, size_t n) noexcept {
+        using S = Simd<T>;
+        size_t i = 0;
+
+        for (; i + S::WIDTH <= n; i += S::WIDTH) {
+            S::Store(out + i, S::Fma(S::Load(a + i), S::Load(b + i), S::Load(c + i)));
+        }
+
+        ScalarKernels::Fma(a + i, b + i, c + i, out + i, n - i);
+    }
+
+    template<typename T>
+    static void ScaledCopy(const T *src, T scale, T *dst, size_t n) noexcept {
+        using S = Simd<T>;
+        const typename S::Reg factor = S::Set1(scale);
+        size_t i = 0;
+
+        for (; i + S::WIDTH <= n; i += S::WIDTH) {
+            S::Store(dst + i, S::Mul(S::Load(src + i), factor));
+        }
+
+        ScalarKernels::ScaledCopy(src + i, scale, dst + i, n - i);
+    }
+
+    template<typename T>
+    static size_t Find(const T *data, size_t n, T value) noexcept {
+        using S = Simd<T>;
+        const typename S::Reg needle = S::Set1(value);
+        size_t i = 0;
+
+        for (; i + S::WIDTH <= n; i += S::WIDTH) {
+            const unsigned mask = S::EqMask(S::Load(data + i), needle);
+
+            if (mask != 0) {
+                return i + static_cast<size_t>(__builtin_ctz(mask));
+            }
+        }
+
+        return i + ScalarKernels::Find(data + i, n - i, value);
+    }
+
+    template<typename T>
+    static size_t Count(const T *data, size_t n, T value) noexcept {
+        using S = Simd<T>;
+        const typename S::Reg needle = S::Set1(value);
+        size_t count = 0;
+        size_t i = 0;
+
+        for (; i + S::WIDTH <= n; i += S::WIDTH) {
+            count += static_cast<size_t>(__builtin_popcount(S::EqMask(S::Load(data + i), needle)));
+        }
+
+        return count + ScalarKernels::Count(data + i, n - i, value);
+    }
+
+    // Внутри регистра — сдвиги со сложением за log2(WIDTH) шагов, между регистрами переносится последняя сумма
+    template<typename T>
+    static void PrefixSum(const T *in, T *out, size_t n) noexcept {
+        using S = Simd<T>;
+        constexpr size_t W = S::WIDTH;
+
+        typename S::Reg carry = S::Zero();
+        size_t i = 0;
+
+        for (; i + W <= n; i += W) {
+            typename S::Reg x = S::Load(in + i);
+
+            for (size_t shift = 1; shift < W; shift *= 2) {
+                x = S::Add(x, S::ShiftUp(x, shift));
+            }
+
+            S::Store(out + i, S::Add(x, carry));
+            carry = S::Set1(out[i + W - 1]);
+        }
+
+        for (; i != n; ++i) {
+            out[i] = i == 0 ? in[i] : WrapAdd(out[i - 1], in[i]);
+        }
+    }
+};
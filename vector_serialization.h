@@ -0,0 +1,412 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Заголовок сериализованного вектора. Поля фиксированной ширины и без выравнивающих дыр,
+// поэтому заголовок пишется и читается целиком. Порядок байтов проверяется до остальных полей.
+struct VectorFileHeader {
+    static constexpr uint32_t MAGIC = 0x31434556; // "VEC1"
+    static constexpr uint16_t VERSION = 1;
+
+    enum ByteOrder : uint8_t {
+        LITTLE_ENDIAN_ORDER = 1,
+        BIG_ENDIAN_ORDER = 2,
+    };
+
+    enum Encoding : uint8_t {
+        // Элементы записаны байтами своего представления в памяти
+        BITWISE = 1,
+        // Элементы записаны кодеком, element_size и element_alignment справочные
+        ENCODED = 2,
+    };
+
+    uint32_t magic;
+    uint16_t version;
+    uint8_t byte_order;
+    uint8_t encoding;
+    uint32_t element_size;
+    uint32_t element_alignment;
+    uint64_t count;
+};
+
+static_assert(sizeof(VectorFileHeader) == 24 && std::is_trivially_copyable_v<VectorFileHeader>);
+
+inline uint8_t NativeByteOrder() noexcept {
+    const uint16_t probe = 1;
+    unsigned char first_byte;
+    std::memcpy(&first_byte, &probe, 1);
+    return first_byte == 1 ? VectorFileHeader::LITTLE_ENDIAN_ORDER : VectorFileHeader::BIG_ENDIAN_ORDER;
+}
+
+// Кодек по умолчанию: элементы копируются блоками как есть. Подходит только для тривиально копируемых T.
+template<typename T>
+struct BitwiseCodec {
+    static_assert(std::is_trivially_copyable_v<T>, "use a custom codec for non-trivially copyable types");
+
+    static constexpr bool IS_BITWISE = true;
+};
+
+// Пользовательский кодек задаёт IS_BITWISE = false и поэлементные функции:
+//     static void Encode(std::ostream &os, const T &value);
+//     static T Decode(std::istream &is);
+// Ошибки кодек сообщает исключением или выставляя состояние потока.
+
+template<typename T, typename Codec = BitwiseCodec<T>>
+VectorFileHeader MakeVectorFileHeader(uint64_t count) noexcept {
+    return VectorFileHeader{VectorFileHeader::MAGIC, VectorFileHeader::VERSION, NativeByteOrder(),
+                            Codec::IS_BITWISE ? VectorFileHeader::BITWISE : VectorFileHeader::ENCODED,
+                            static_cast<uint32_t>(sizeof(T)), static_cast<uint32_t>(alignof(T)), count};
+}
+
+// Бросает std::runtime_error, если данные под заголовком нельзя прочитать как элементы T этим кодеком
+template<typename T, typename Codec = BitwiseCodec<T>>
+void CheckVectorFileHeader(const VectorFileHeader &header) {
+    const VectorFileHeader expected = MakeVectorFileHeader<T, Codec>(header.count);
+
+    if (header.byte_order != expected.byte_order) {
+        throw std::runtime_error("VectorFileHeader: byte order mismatch");
+    }
+
+    if (header.magic != expected.magic || header.version != expected.version) {
+        throw std::runtime_error("VectorFileHeader: unknown format");
+    }
+
+    if (header.encoding != expected.encoding) {
+        throw std::runtime_error("VectorFileHeader: encoding mismatch");
+    }
+
+    if (Codec::IS_BITWISE && (header.element_size != expected.element_size
+                              || header.element_alignment != expected.element_alignment)) {
+        throw std::runtime_error("VectorFileHeader: element layout mismatch");
+    }
+}
+
+// Число элементов из заголовка, если оно не больше max_count и их байты помещаются в size_t.
+// Иначе std::runtime_error: повреждённый заголовок не должен приводить к огромному выделению памяти
+template<typename T>
+size_t CheckedElementCount(const VectorFileHeader &header, size_t max_count, const char *what) {
+    const size_t limit = std::min(max_count, static_cast<size_t>(-1) / sizeof(T));
+
+    if (header.count > limit) {
+        throw std::runtime_error(std::string(what) + ": element count exceeds the limit");
+    }
+
+    return static_cast<size_t>(header.count);
+}
+
+// Пишет заголовок с числом элементов count и затем элементы порциями. Всего должно быть записано ровно count элементов.
+template<typename T, typename Codec = BitwiseCodec<T>>
+class VectorStreamWriter {
+public:
+    VectorStreamWriter(std::ostream &os, size_t count);
+
+    void Write(const T *items, size_t count);
+
+    size_t Remaining() const noexcept {return remaining_;}
+
+private:
+    std::ostream &os_;
+    size_t remaining_;
+};
+
+// Читает заголовок и затем элементы порциями, дописывая их в конец существующего вектора.
+// Заголовок с числом элементов больше max_count отвергается. Если поток позволяет узнать свою длину,
+// бинарный заголовок не может обещать больше элементов, чем байтов осталось в потоке
+template<typename T, typename Codec = BitwiseCodec<T>>
+class VectorStreamReader {
+public:
+    explicit VectorStreamReader(std::istream &is, size_t max_count = static_cast<size_t>(-1));
+
+    // Дописывает в out до max_count элементов и возвращает их число. Память растёт вместе с прочитанными
+    // порциями, а не резервируется заранее по заголовку, бинарные данные читаются прямо в буфер вектора.
+    // Если данных не хватило, out возвращается к прежнему размеру.
+    template<typename Allocator, typename GrowthPolicy>
+    size_t Read(Vector<T, Allocator, GrowthPolicy> &out, size_t max_count = static_cast<size_t>(-1));
+
+    size_t Count() const noexcept {return count_;}
+
+    size_t Remaining() const noexcept {return remaining_;}
+
+private:
+    // Байты от текущей позиции до конца потока или -1, если поток не поддерживает позиционирование
+    std::streamoff BytesLeft();
+
+    std::istream &is_;
+    size_t count_ = 0;
+    size_t remaining_ = 0;
+};
+
+template<typename T, typename Codec>
+VectorStreamWriter<T, Codec>::VectorStreamWriter(std::ostream &os, size_t count)
+        : os_(os), remaining_(count) {
+    const VectorFileHeader header = MakeVectorFileHeader<T, Codec>(count);
+    os_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    if (!os_) {
+        throw std::runtime_error("VectorStreamWriter: write failed");
+    }
+}
+
+template<typename T, typename Codec>
+void VectorStreamWriter<T, Codec>::Write(const T *items, size_t count) {
+
+    if (count > remaining_) {
+        throw std::logic_error("VectorStreamWriter: more elements than declared in the header");
+    }
+
+    if constexpr (Codec::IS_BITWISE) {
+        os_.write(reinterpret_cast<const char *>(items), static_cast<std::streamsize>(count * sizeof(T)));
+    } else {
+        for (size_t i = 0; i != count && os_; ++i) {
+            Codec::Encode(os_, items[i]);
+        }
+    }
+
+    if (!os_) {
+        throw std::runtime_error("VectorStreamWriter: write failed");
+    }
+
+    remaining_ -= count;
+}
+
+template<typename T, typename Codec>
+VectorStreamReader<T, Codec>::VectorStreamReader(std::istream &is, size_t max_count)
+        : is_(is) {
+    VectorFileHeader header{};
+    is_.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+    if (!is_) {
+        throw std::runtime_error("VectorStreamReader: truncated header");
+    }
+
+    CheckVectorFileHeader<T, Codec>(header);
+    count_ = remaining_ = CheckedElementCount<T>(header, max_count, "VectorStreamReader");
+
+    if constexpr (Codec::IS_BITWISE) {
+        const std::streamoff bytes_left = BytesLeft();
+
+        if (bytes_left >= 0 && count_ > static_cast<size_t>(bytes_left) / sizeof(T)) {
+            throw std::runtime_error("VectorStreamReader: truncated data");
+        }
+    }
+}
+
+template<typename T, typename Codec>
+std::streamoff VectorStreamReader<T, Codec>::BytesLeft() {
+    const std::istream::pos_type pos = is_.tellg();
+
+    if (pos == std::istream::pos_type(-1)) {
+        is_.clear();
+        return -1;
+    }
+
+    is_.seekg(0, std::ios::end);
+    const std::istream::pos_type end = is_.tellg();
+    is_.seekg(pos);
+
+    if (!is_ || end == std::istream::pos_type(-1)) {
+        is_.clear();
+        is_.seekg(pos);
+        return -1;
+    }
+
+    return end - pos;
+}
+
+template<typename T, typename Codec>
+template<typename Allocator, typename GrowthPolicy>
+size_t VectorStreamReader<T, Codec>::Read(Vector<T, Allocator, GrowthPolicy> &out, size_t max_count) {
+    const size_t count = std::min(max_count, remaining_);
+    const size_t old_size = out.Size();
+
+    if (count == 0) {
+        return 0;
+    }
+
+    if (count > static_cast<size_t>(-1) / sizeof(T) - old_size) {
+        throw std::length_error("VectorStreamReader: vector size overflow");
+    }
+
+    try {
+        if constexpr (Codec::IS_BITWISE) {
+            out.ResizeForOverwrite(old_size + count);
+            is_.read(reinterpret_cast<char *>(out.Data() + old_size), static_cast<std::streamsize>(count * sizeof(T)));
+        } else {
+            for (size_t i = 0; i != count && is_; ++i) {
+                T item = Codec::Decode(is_);
+
+                if (is_) {
+                    out.EmplaceBack(std::move(item));
+                }
+            }
+        }
+
+        if (!is_) {
+            throw std::runtime_error("VectorStreamReader: truncated data");
+        }
+    } catch (...) {
+        out.Erase(out.begin() + old_size, out.end());
+        throw;
+    }
+
+    remaining_ -= count;
+    return count;
+}
+
+// Сохраняет вектор целиком порциями по ChunkSize элементов
+template<typename Codec = void, size_t ChunkSize = 4096, typename T, typename Allocator, typename GrowthPolicy>
+void SaveVector(std::ostream &os, const Vector<T, Allocator, GrowthPolicy> &v) {
+    using ElementCodec = std::conditional_t<std::is_void_v<Codec>, BitwiseCodec<T>, Codec>;
+    VectorStreamWriter<T, ElementCodec> writer(os, v.Size());
+
+    for (size_t offset = 0; offset < v.Size(); offset += ChunkSize) {
+        writer.Write(v.Data() + offset, std::min(ChunkSize, v.Size() - offset));
+    }
+}
+
+// Заменяет содержимое вектора сохранённым, не больше max_count элементов. При ошибке вектор остаётся пустым
+template<typename Codec = void, size_t ChunkSize = 4096, typename T, typename Allocator, typename GrowthPolicy>
+void LoadVector(std::istream &is, Vector<T, Allocator, GrowthPolicy> &v, size_t max_count = static_cast<size_t>(-1)) {
+    using ElementCodec = std::conditional_t<std::is_void_v<Codec>, BitwiseCodec<T>, Codec>;
+    v.Clear();
+
+    VectorStreamReader<T, ElementCodec> reader(is, max_count);
+
+    // Read откатывает только свою порцию, поэтому уже прочитанные порции убираются здесь
+    try {
+        while (reader.Remaining() != 0) {
+            reader.Read(v, ChunkSize);
+        }
+    } catch (...) {
+        v.Clear();
+        throw;
+    }
+}
+
+namespace serialization_detail {
+
+    [[noreturn]] inline void ThrowSystemError(const char *what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // Байты от текущей позиции до конца обычного файла или -1 для каналов, сокетов и устройств
+    inline off_t FileBytesLeft(int fd) noexcept {
+        struct stat st{};
+
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            return -1;
+        }
+
+        const off_t pos = lseek(fd, 0, SEEK_CUR);
+        return pos < 0 ? -1 : std::max<off_t>(st.st_size - pos, 0);
+    }
+
+    // Дочитывает ровно size байт, повторяя read после частичного чтения и EINTR
+    inline void ReadFull(int fd, void *buf, size_t size) {
+        auto *pos = static_cast<char *>(buf);
+
+        while (size != 0) {
+            const ssize_t n = read(fd, pos, size);
+
+            if (n == 0) {
+                throw std::runtime_error("ReadVector: unexpected end of file");
+            }
+
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ThrowSystemError("ReadVector: read");
+            }
+
+            pos += n;
+            size -= static_cast<size_t>(n);
+        }
+    }
+
+} // namespace serialization_detail
+
+// Записывает заголовок и все элементы одним writev без промежуточного буфера
+template<typename T, typename Allocator, typename GrowthPolicy>
+void WriteVector(int fd, const Vector<T, Allocator, GrowthPolicy> &v) {
+    const VectorFileHeader header = MakeVectorFileHeader<T>(v.Size());
+
+    iovec iov[2] = {
+            {const_cast<VectorFileHeader *>(&header), sizeof(header)},
+            {const_cast<T *>(v.Data()), v.Size() * sizeof(T)},
+    };
+    iovec *first = iov;
+    int iov_count = 2;
+
+    while (iov_count != 0) {
+        const ssize_t n = writev(fd, first, iov_count);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            serialization_detail::ThrowSystemError("WriteVector: writev");
+        }
+
+        // После частичной записи пропускаем записанное и продолжаем с того же места
+        size_t written = static_cast<size_t>(n);
+
+        while (iov_count != 0 && written >= first->iov_len) {
+            written -= first->iov_len;
+            ++first;
+            --iov_count;
+        }
+
+        if (iov_count != 0) {
+            first->iov_base = static_cast<char *>(first->iov_base) + written;
+            first->iov_len -= written;
+        }
+    }
+}
+
+// Заменяет содержимое вектора, не больше max_count элементов, читая прямо в буфер вектора.
+// Из обычного файла, размер которого подтверждает заголовок, элементы читаются за одно выделение памяти;
+// из канала — порциями по ChunkSize, чтобы память росла только вместе с пришедшими данными.
+// При ошибке вектор остаётся пустым
+template<size_t ChunkSize = 65536, typename T, typename Allocator, typename GrowthPolicy>
+void ReadVector(int fd, Vector<T, Allocator, GrowthPolicy> &v, size_t max_count = static_cast<size_t>(-1)) {
+    v.Clear();
+
+    VectorFileHeader header{};
+    serialization_detail::ReadFull(fd, &header, sizeof(header));
+    CheckVectorFileHeader<T>(header);
+    const size_t count = CheckedElementCount<T>(header, max_count, "ReadVector");
+    const off_t bytes_left = serialization_detail::FileBytesLeft(fd);
+
+    if (bytes_left >= 0 && count > static_cast<size_t>(bytes_left) / sizeof(T)) {
+        throw std::runtime_error("ReadVector: unexpected end of file");
+    }
+
+    const size_t chunk = bytes_left >= 0 ? std::max<size_t>(count, 1) : ChunkSize;
+
+    try {
+        for (size_t offset = 0; offset < count; offset += chunk) {
+            const size_t n = std::min(chunk, count - offset);
+            v.ResizeForOverwrite(offset + n);
+            serialization_detail::ReadFull(fd, v.Data() + offset, n * sizeof(T));
+        }
+    } catch (...) {
+        v.Clear();
+        throw;
+    }
+}